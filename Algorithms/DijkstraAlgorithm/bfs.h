@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+
+
+namespace ShortestPaths {
+    constexpr size_t UNREACHED = std::numeric_limits<size_t>::max();
+
+    struct BFSTree final {
+        std::vector<size_t> levels;         // hops from the source, UNREACHED if there is no path
+        std::vector<size_t> parents;        // previous vertex on a shortest path, the source is its own parent
+    };
+
+    template<typename G>
+    class BreadthFirstSearch final {
+        /**
+        *  @brief Direction-optimizing BFS (Beamer, Asanovic, Patterson). Top-down steps expand the frontier
+        *  queue, bottom-up steps let every unvisited vertex look for a parent in the frontier bitmap, which is
+        *  much cheaper once the frontier holds a large share of the edges. Both kinds of steps run on all
+        *  threads. The engine is built once per graph and reused across queries; for directed graphs it
+        *  keeps the in-edges needed by bottom-up steps.
+        */
+        static constexpr size_t ALPHA = 14;         // go bottom-up when frontier edges > unexplored edges / ALPHA
+        static constexpr size_t BETA = 24;          // go back top-down when the frontier < vertices / BETA
+        static constexpr size_t GRAIN = 4096;       // smaller steps stay on the calling thread
+
+        struct alignas(64) Worker final {
+            std::vector<size_t> queue;
+            size_t vertices = 0;
+            size_t edges = 0;
+        };
+
+        const G &g;
+        size_t threads;
+        bool directed;
+        std::vector<size_t> in_offsets;
+        std::vector<size_t> in_sources;
+
+        std::vector<std::atomic<size_t>> parents;
+        std::vector<size_t> levels;
+        std::vector<size_t> frontier;
+        std::vector<uint64_t> current;
+        std::vector<uint64_t> next;
+        std::vector<Worker> workers;
+
+        size_t workers_for(size_t work) const {
+            return std::max<size_t>(1, std::min(threads, work / GRAIN));
+        };
+
+        size_t parent_in_frontier(size_t vertex) const;
+
+        size_t top_down(size_t level);
+
+        size_t bottom_up(size_t level);
+
+        void collect(size_t &vertices, size_t &edges);
+
+    public:
+        explicit BreadthFirstSearch(const G &new_g, size_t new_threads = ThreadPool::default_threads());
+
+        BFSTree run(size_t source);
+    };
+
+    template<typename G>
+    BreadthFirstSearch<G>::BreadthFirstSearch(const G &new_g, size_t new_threads) :
+            g(new_g), threads(std::max<size_t>(1, new_threads)), directed(graph::is_directed(new_g)),
+            parents(new_g.number_of_vertices()), levels(new_g.number_of_vertices(), UNREACHED),
+            current((new_g.number_of_vertices() + 63) / 64, 0), next((new_g.number_of_vertices() + 63) / 64, 0),
+            workers(threads) {
+        if (!directed) {
+            return;
+        }
+
+        size_t n = g.number_of_vertices();
+        in_offsets.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &it : g[i]) {
+                ++in_offsets[graph::target_of(it) + 1];
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            in_offsets[i + 1] += in_offsets[i];
+        }
+
+        std::vector<size_t> fill(in_offsets.begin(), in_offsets.end() - 1);
+        in_sources.resize(in_offsets[n]);
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &it : g[i]) {
+                in_sources[fill[graph::target_of(it)]++] = i;
+            }
+        }
+    }
+
+    template<typename G>
+    size_t BreadthFirstSearch<G>::parent_in_frontier(size_t vertex) const {
+        if (directed) {
+            for (size_t i = in_offsets[vertex], end_ = in_offsets[vertex + 1]; i < end_; ++i) {
+                size_t source = in_sources[i];
+                if (current[source / 64] >> (source % 64) & 1u) {
+                    return source;
+                }
+            }
+            return UNREACHED;
+        }
+
+        for (const auto &it : g[vertex]) {
+            size_t source = graph::target_of(it);
+            if (current[source / 64] >> (source % 64) & 1u) {
+                return source;
+            }
+        }
+        return UNREACHED;
+    }
+
+    template<typename G>
+    void BreadthFirstSearch<G>::collect(size_t &vertices, size_t &edges) {
+        vertices = edges = 0;
+        for (auto &it : workers) {
+            vertices += it.vertices;
+            edges += it.edges;
+            it.vertices = it.edges = 0;
+        }
+    }
+
+    template<typename G>
+    size_t BreadthFirstSearch<G>::top_down(size_t level) {
+        /**
+        *  @brief Expands the frontier queue; returns the out-edge count of the next frontier.
+        */
+        ThreadPool::parallel_for(frontier.size(), [this, level](size_t i, size_t worker) {
+            size_t source = frontier[i];
+            auto &state = workers[worker];
+            for (const auto &it : g[source]) {
+                size_t target = graph::target_of(it);
+                size_t expected = UNREACHED;
+                if (parents[target].load(std::memory_order_relaxed) == UNREACHED &&
+                    parents[target].compare_exchange_strong(expected, source, std::memory_order_relaxed)) {
+                    levels[target] = level + 1;
+                    state.queue.push_back(target);
+                    state.edges += g[target].size();
+                }
+            }
+        }, workers_for(frontier.size()));
+
+        frontier.clear();
+        size_t edges = 0;
+        for (auto &it : workers) {
+            frontier.insert(frontier.end(), it.queue.begin(), it.queue.end());
+            it.queue.clear();
+            edges += it.edges;
+            it.edges = 0;
+        }
+        return edges;
+    }
+
+    template<typename G>
+    size_t BreadthFirstSearch<G>::bottom_up(size_t level) {
+        /**
+        *  @brief One bottom-up step from the current bitmap into next; every 64-vertex word belongs to a
+        *  single worker, so the bitmap needs no atomics. Returns the size of the next frontier.
+        */
+        size_t n = g.number_of_vertices();
+        ThreadPool::parallel_for(current.size(), [this, level, n](size_t word, size_t worker) {
+            auto &state = workers[worker];
+            uint64_t bits = 0;
+            for (size_t vertex = word * 64, end_ = std::min(n, vertex + 64); vertex < end_; ++vertex) {
+                if (parents[vertex].load(std::memory_order_relaxed) != UNREACHED) {
+                    continue;
+                }
+
+                size_t parent = parent_in_frontier(vertex);
+                if (parent != UNREACHED) {
+                    parents[vertex].store(parent, std::memory_order_relaxed);
+                    levels[vertex] = level + 1;
+                    bits |= static_cast<uint64_t>(1) << (vertex % 64);
+                    ++state.vertices;
+                    state.edges += g[vertex].size();
+                }
+            }
+            next[word] = bits;
+        }, workers_for(n));
+
+        current.swap(next);
+        size_t vertices = 0;
+        size_t edges = 0;
+        collect(vertices, edges);
+        return vertices;
+    }
+
+    template<typename G>
+    BFSTree BreadthFirstSearch<G>::run(size_t source) {
+        size_t n = g.number_of_vertices();
+        if (source >= n) {
+            throw std::invalid_argument("start position");
+        }
+
+        for (auto &it : parents) {
+            it.store(UNREACHED, std::memory_order_relaxed);
+        }
+        levels.assign(n, UNREACHED);
+
+        size_t unexplored = 0;      // out-edges of vertices not reached yet
+        for (size_t i = 0; i < n; ++i) {
+            unexplored += g[i].size();
+        }
+
+        parents[source].store(source, std::memory_order_relaxed);
+        levels[source] = 0;
+        unexplored -= g[source].size();
+        frontier.assign(1, source);
+
+        size_t frontier_edges = g[source].size();
+        for (size_t level = 0; !frontier.empty(); ++level) {
+            if (frontier_edges > unexplored / ALPHA) {
+                std::fill(current.begin(), current.end(), 0);
+                for (const auto &it : frontier) {
+                    current[it / 64] |= static_cast<uint64_t>(1) << (it % 64);
+                }
+
+                size_t size = frontier.size();
+                size_t previous;
+                do {
+                    previous = size;
+                    size = bottom_up(level++);
+                } while (size && (size >= previous || size > n / BETA));
+                --level;
+
+                frontier.clear();
+                for (size_t word = 0, end_ = current.size(); word < end_; ++word) {
+                    for (uint64_t bits = current[word]; bits; bits &= bits - 1) {
+                        frontier.push_back(word * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+                    }
+                }
+
+                frontier_edges = 0;
+                for (const auto &it : frontier) {
+                    frontier_edges += g[it].size();
+                }
+                unexplored = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    if (parents[i].load(std::memory_order_relaxed) == UNREACHED) {
+                        unexplored += g[i].size();
+                    }
+                }
+                continue;
+            }
+
+            frontier_edges = top_down(level);
+            unexplored -= std::min(unexplored, frontier_edges);
+        }
+
+        BFSTree result;
+        result.levels = levels;
+        result.parents.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.parents[i] = parents[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    template<typename G>
+    BFSTree bfs(const G &g, size_t source, size_t threads = ThreadPool::default_threads()) {
+        static_assert(graph::is_graph_v<G>, "bfs expects a graph");
+        return BreadthFirstSearch<G>(g, threads).run(source);
+    }
+}
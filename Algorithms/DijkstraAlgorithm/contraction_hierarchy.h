@@ -0,0 +1,765 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../DataStructures/binary_heap/binary_heap.h"
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+#include "dijkstra.h"
+#include "distance_table.h"
+#include "point_to_point.h"
+
+
+/*
+ * Contraction hierarchy file layout (native byte order, every section is made of 8-byte words):
+ *
+ *   HierarchyHeader
+ *   uint64_t ranks[vertices]
+ *   uint64_t upward_offsets[vertices + 1]
+ *   Arc      upward[upward_entries]
+ *   uint64_t downward_offsets[vertices + 1]
+ *   Arc      downward[downward_entries]
+ */
+namespace ShortestPaths {
+    namespace hierarchy {
+        constexpr char MAGIC[8] = {'A', 'D', 'S', 'C', 'H', 'I', 'E', 'R'};
+        constexpr uint32_t VERSION = 1;
+
+        constexpr uint64_t NO_MIDDLE = std::numeric_limits<uint64_t>::max();
+
+        struct Arc final {
+            uint64_t target;
+            uint64_t weight;
+            uint64_t middle;        // vertex a shortcut bypasses, NO_MIDDLE for edges of the input graph
+        };
+
+        struct HierarchyHeader final {
+            char magic[8];
+            uint32_t version;
+            uint32_t reserved;
+            uint64_t vertices;
+            uint64_t upward_entries;
+            uint64_t downward_entries;
+        };
+
+        static_assert(sizeof(Arc) == 24 && sizeof(HierarchyHeader) % 8 == 0, "sections must stay 8-byte aligned");
+    }
+
+
+    namespace detail {
+        class HierarchyBuilder final {
+            /**
+            *  @brief The shrinking overlay graph of the preprocessing: out and in arcs of every vertex that is
+            *  not contracted yet, at most one arc per ordered pair. Witness searches are bounded local Dijkstra
+            *  runs whose scratch is invalidated by bumping a stamp instead of clearing it.
+            */
+            using Arc = hierarchy::Arc;
+
+            std::vector<std::vector<Arc>> out;
+            std::vector<std::vector<Arc>> in;
+            std::vector<int64_t> deleted;       // contracted neighbors, spreads contraction over the graph
+            std::vector<int64_t> levels;        // bound on the depth of the hierarchy below a vertex
+
+            std::vector<uint64_t> distances;
+            std::vector<size_t> stamps;
+            std::vector<size_t> wanted;         // equals stamp for the targets of the current witness search
+            size_t stamp;
+            BinaryHeap::IndexedBinaryHeap<uint64_t> heap;
+
+            static Arc *find(std::vector<Arc> &row, uint64_t target) {
+                for (auto &it : row) {
+                    if (it.target == target) {
+                        return &it;
+                    }
+                }
+                return nullptr;
+            };
+
+            static void erase(std::vector<Arc> &row, uint64_t target) {
+                for (auto &it : row) {
+                    if (it.target == target) {
+                        it = row.back();
+                        row.pop_back();
+                        return;
+                    }
+                }
+            };
+
+            void add_arc(size_t source, size_t target, uint64_t weight, uint64_t middle) {
+                Arc *existing = find(out[source], target);
+                if (!existing) {
+                    out[source].push_back({target, weight, middle});
+                    in[target].push_back({source, weight, middle});
+                } else if (weight < existing->weight) {
+                    *existing = {target, weight, middle};
+                    *find(in[target], source) = {source, weight, middle};
+                }
+            };
+
+            uint64_t reached(size_t vertex) const {
+                return stamps[vertex] == stamp ? distances[vertex] : INFINITE_DISTANCE;
+            };
+
+            void witness_search(size_t source, size_t skip, uint64_t limit, size_t remaining, size_t settle_limit);
+
+            template<typename F>
+            void for_each_shortcut(size_t vertex, size_t settle_limit, F &&f);
+
+        public:
+            static constexpr size_t CONTRACTION_SETTLES = 500;     // witness search budget when contracting
+            static constexpr size_t SIMULATION_SETTLES = 50;       // and when only estimating a priority
+
+            template<typename G>
+            explicit HierarchyBuilder(const G &g);
+
+            int64_t priority(size_t vertex);
+
+            void contract(size_t vertex, std::vector<Arc> &upward, std::vector<Arc> &downward);
+        };
+
+        template<typename G>
+        HierarchyBuilder::HierarchyBuilder(const G &g) : out(g.number_of_vertices()), in(g.number_of_vertices()),
+                                                         deleted(g.number_of_vertices(), 0),
+                                                         levels(g.number_of_vertices(), 0),
+                                                         distances(g.number_of_vertices(), 0),
+                                                         stamps(g.number_of_vertices(), 0),
+                                                         wanted(g.number_of_vertices(), 0), stamp(0),
+                                                         heap(g.number_of_vertices()) {
+            size_t n = g.number_of_vertices();
+            for (size_t i = 0; i < n; ++i) {
+                auto &row = out[i];
+                for (const auto &it : g[i]) {
+                    size_t target = graph::target_of(it);
+                    if (target != i) {      // a loop never lies on a shortest path
+                        row.push_back({target, graph::weight_of(it), hierarchy::NO_MIDDLE});
+                    }
+                }
+
+                std::sort(row.begin(), row.end(), [](const Arc &a, const Arc &b) {
+                    return a.target < b.target || (a.target == b.target && a.weight < b.weight);
+                });
+                row.erase(std::unique(row.begin(), row.end(), [](const Arc &a, const Arc &b) {
+                    return a.target == b.target;
+                }), row.end());
+                for (const auto &it : row) {
+                    in[it.target].push_back({i, it.weight, it.middle});
+                }
+            }
+        }
+
+        inline void HierarchyBuilder::witness_search(size_t source, size_t skip, uint64_t limit, size_t remaining,
+                                                     size_t settle_limit) {
+            /**
+            *  @brief Distances from source avoiding skip, exact up to limit unless the search gives up after
+            *  settle_limit vertices; it also stops once the remaining wanted vertices are all settled.
+            */
+            heap.clear();
+            distances[source] = 0;
+            stamps[source] = stamp;
+            heap.insert(0, source);
+
+            for (size_t settled = 0; !heap.empty() && settled < settle_limit; ++settled) {
+                auto node = heap.extract_min();
+                if (node.get_key() > limit) {
+                    break;
+                }
+                if (wanted[node.get_value()] == stamp && --remaining == 0) {
+                    break;
+                }
+
+                for (const auto &it : out[node.get_value()]) {
+                    uint64_t candidate = saturating_add<uint64_t>(node.get_key(), it.weight);
+                    if (it.target != skip && candidate <= limit && candidate < reached(it.target)) {
+                        distances[it.target] = candidate;
+                        stamps[it.target] = stamp;
+                        heap.insert_or_decrease(candidate, it.target);
+                    }
+                }
+            }
+        }
+
+        template<typename F>
+        void HierarchyBuilder::for_each_shortcut(size_t vertex, size_t settle_limit, F &&f) {
+            /**
+            *  @brief Calls f(u, x, weight) for every pair u -> vertex -> x that has no witness path avoiding vertex
+            *  of at most the same length. A truncated search may miss a witness, which only costs a shortcut.
+            */
+            for (const auto &first : in[vertex]) {
+                ++stamp;
+                uint64_t longest = 0;
+                size_t targets = 0;
+                for (const auto &second : out[vertex]) {
+                    if (second.target != first.target) {
+                        longest = std::max(longest, second.weight);
+                        wanted[second.target] = stamp;
+                        ++targets;
+                    }
+                }
+                if (targets == 0) {
+                    continue;
+                }
+
+                witness_search(first.target, vertex, saturating_add<uint64_t>(first.weight, longest), targets,
+                               settle_limit);
+                for (const auto &second : out[vertex]) {
+                    // a saturated via is never below reached(), so no shortcut stands for an overflowing path
+                    uint64_t via = saturating_add<uint64_t>(first.weight, second.weight);
+                    if (second.target != first.target && via < reached(second.target)) {
+                        f(first.target, second.target, via);
+                    }
+                }
+            }
+        }
+
+        inline int64_t HierarchyBuilder::priority(size_t vertex) {
+            /**
+            *  @brief Edge difference (shortcuts added minus arcs removed) plus the number of contracted
+            *  neighbors and the level, so cheap vertices go first and contraction stays spread out.
+            */
+            int64_t added = 0;
+            for_each_shortcut(vertex, SIMULATION_SETTLES, [&added](size_t, size_t, uint64_t) {
+                ++added;
+            });
+            auto removed = static_cast<int64_t>(in[vertex].size() + out[vertex].size());
+            return 4 * (added - removed) + 2 * deleted[vertex] + levels[vertex];
+        }
+
+        inline void HierarchyBuilder::contract(size_t vertex, std::vector<Arc> &upward, std::vector<Arc> &downward) {
+            /**
+            *  @brief Adds the shortcuts that replace vertex, then moves its remaining arcs, which all lead to
+            *  higher ranked vertices, into upward (out arcs) and downward (in arcs) and unlinks it.
+            */
+            for_each_shortcut(vertex, CONTRACTION_SETTLES, [this, vertex](size_t from, size_t to, uint64_t weight) {
+                add_arc(from, to, weight, vertex);
+            });
+
+            upward.swap(out[vertex]);
+            downward.swap(in[vertex]);
+            out[vertex].clear();
+            in[vertex].clear();
+
+            for (const auto &it : upward) {
+                erase(in[it.target], vertex);
+                ++deleted[it.target];
+                levels[it.target] = std::max(levels[it.target], levels[vertex] + 1);
+            }
+            for (const auto &it : downward) {
+                erase(out[it.target], vertex);
+                ++deleted[it.target];
+                levels[it.target] = std::max(levels[it.target], levels[vertex] + 1);
+            }
+        }
+    }
+
+
+    class ContractionHierarchy final {
+        /**
+        *  @brief Contraction hierarchies (Geisberger et al.). Preprocessing contracts vertices one by one in the
+        *  order of a lazily updated priority, adding shortcuts that keep distances among the remaining vertices,
+        *  and ranks them in that order. A query then runs Dijkstra from both ends over arcs that lead to higher
+        *  ranks only, with stall-on-demand, and unpacks shortcuts into the original path.
+        *  Queries reuse scratch arrays owned by the hierarchy, so one hierarchy serves one thread at a time.
+        */
+        using Arc = hierarchy::Arc;
+
+        struct Search final {
+            std::vector<uint64_t> distances;
+            std::vector<uint64_t> parents;
+            std::vector<uint64_t> middles;      // middle of the arc from the parent
+            std::vector<size_t> touched;
+            BinaryHeap::IndexedBinaryHeap<uint64_t> heap;
+
+            void resize(size_t n) {
+                distances.assign(n, INFINITE_DISTANCE);
+                parents.assign(n, INFINITE_DISTANCE);
+                middles.assign(n, hierarchy::NO_MIDDLE);
+                touched.clear();
+                heap.resize(n);
+            };
+
+            void reset() {
+                for (const auto &it : touched) {
+                    distances[it] = INFINITE_DISTANCE;
+                }
+                touched.clear();
+                heap.clear();
+            };
+
+            void reach(size_t vertex, uint64_t distance, size_t parent, uint64_t middle) {
+                if (distances[vertex] == INFINITE_DISTANCE) {
+                    touched.push_back(vertex);
+                }
+                distances[vertex] = distance;
+                parents[vertex] = parent;
+                middles[vertex] = middle;
+                heap.insert_or_decrease(distance, vertex);
+            };
+        };
+
+        std::vector<uint64_t> ranks;
+        std::vector<uint64_t> upward_offsets;       // arcs to higher ranks leaving v
+        std::vector<Arc> upward;
+        std::vector<uint64_t> downward_offsets;     // arcs from higher ranks entering v, target is their source
+        std::vector<Arc> downward;
+        Search forward;
+        Search backward;
+
+        void flatten(const std::vector<std::vector<Arc>> &rows, std::vector<uint64_t> &offsets,
+                     std::vector<Arc> &arcs);
+
+        static bool stalled(const Search &side, size_t vertex, const std::vector<uint64_t> &stall_offsets,
+                            const std::vector<Arc> &stall_arcs);
+
+        template<typename F>
+        void sweep(Search &side, size_t source, bool up, F &&f) const;
+
+        void settle(Search &side, const Search &other, const std::vector<uint64_t> &offsets,
+                    const std::vector<Arc> &arcs, const std::vector<uint64_t> &stall_offsets,
+                    const std::vector<Arc> &stall_arcs, uint64_t &best, size_t &meeting);
+
+        uint64_t search(size_t source, size_t target, size_t &meeting);
+
+        uint64_t middle_of(size_t from, size_t to) const;
+
+        void unpack(size_t from, size_t to, uint64_t middle, std::vector<size_t> &path) const;
+
+    public:
+        ContractionHierarchy() : upward_offsets(1, 0), downward_offsets(1, 0) {};
+
+        template<typename G>
+        explicit ContractionHierarchy(const G &g);
+
+        static ContractionHierarchy load(const std::string &path);
+
+        void save(const std::string &path) const;
+
+        [[nodiscard]] size_t number_of_vertices() const {
+            return ranks.size();
+        };
+
+        [[nodiscard]] size_t number_of_shortcuts() const {
+            size_t result = 0;
+            for (const auto &it : upward) {
+                result += it.middle != hierarchy::NO_MIDDLE;
+            }
+            for (const auto &it : downward) {
+                result += it.middle != hierarchy::NO_MIDDLE;
+            }
+            return result;
+        };
+
+        [[nodiscard]] size_t rank(size_t vertex) const {
+            return ranks[vertex];
+        };
+
+        size_t distance(size_t source, size_t target) {
+            size_t meeting;
+            return search(source, target, meeting);
+        };
+
+        Route route(size_t source, size_t target);
+
+        DistanceTable table(const std::vector<size_t> &sources, const std::vector<size_t> &targets,
+                            size_t threads = ThreadPool::default_threads()) const;
+    };
+
+    template<typename G>
+    ContractionHierarchy::ContractionHierarchy(const G &g) : ranks(g.number_of_vertices(), 0) {
+        static_assert(graph::is_graph_v<G>, "ContractionHierarchy expects a graph");
+
+        size_t n = g.number_of_vertices();
+        detail::HierarchyBuilder builder(g);
+        std::vector<std::vector<Arc>> up_rows(n), down_rows(n);
+
+        BinaryHeap::IndexedBinaryHeap<int64_t> queue(n);
+        for (size_t i = 0; i < n; ++i) {
+            queue.insert(builder.priority(i), i);
+        }
+
+        for (size_t next_rank = 0; !queue.empty();) {
+            size_t vertex = queue.extract_min().get_value();
+            int64_t key = builder.priority(vertex);
+            if (!queue.empty() && key > queue.get_min().get_key()) {      // stale key, try again later
+                queue.insert(key, vertex);
+                continue;
+            }
+
+            ranks[vertex] = next_rank++;
+            builder.contract(vertex, up_rows[vertex], down_rows[vertex]);
+        }
+
+        flatten(up_rows, upward_offsets, upward);
+        flatten(down_rows, downward_offsets, downward);
+        forward.resize(n);
+        backward.resize(n);
+    }
+
+    inline void ContractionHierarchy::flatten(const std::vector<std::vector<Arc>> &rows,
+                                              std::vector<uint64_t> &offsets, std::vector<Arc> &arcs) {
+        offsets.assign(1, 0);
+        arcs.clear();
+        for (const auto &it : rows) {
+            arcs.insert(arcs.end(), it.begin(), it.end());
+            offsets.push_back(arcs.size());
+        }
+    }
+
+    inline bool ContractionHierarchy::stalled(const Search &side, size_t vertex,
+                                              const std::vector<uint64_t> &stall_offsets,
+                                              const std::vector<Arc> &stall_arcs) {
+        /**
+        *  @brief Stall-on-demand: a higher vertex already reaches this one more cheaply, so the search
+        *  reached it on a path that is not upward and need not continue from it.
+        */
+        uint64_t distance = side.distances[vertex];
+        for (uint64_t i = stall_offsets[vertex]; i < stall_offsets[vertex + 1]; ++i) {
+            const auto &it = stall_arcs[i];
+            if (saturating_add<uint64_t>(side.distances[it.target], it.weight) < distance) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename F>
+    void ContractionHierarchy::sweep(Search &side, size_t source, bool up, F &&f) const {
+        /**
+        *  @brief Complete upward search from source, over upward arcs if up and over downward ones otherwise,
+        *  calling f(vertex, distance) for every settled vertex that is not stalled.
+        */
+        const auto &offsets = up ? upward_offsets : downward_offsets;
+        const auto &arcs = up ? upward : downward;
+        const auto &stall_offsets = up ? downward_offsets : upward_offsets;
+        const auto &stall_arcs = up ? downward : upward;
+
+        side.reset();
+        side.reach(source, 0, source, hierarchy::NO_MIDDLE);
+        while (!side.heap.empty()) {
+            size_t vertex = side.heap.extract_min().get_value();
+            uint64_t distance = side.distances[vertex];
+            if (stalled(side, vertex, stall_offsets, stall_arcs)) {
+                continue;
+            }
+
+            f(vertex, distance);
+            for (uint64_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+                const auto &it = arcs[i];
+                uint64_t candidate = saturating_add<uint64_t>(distance, it.weight);
+                if (candidate < side.distances[it.target]) {
+                    side.reach(it.target, candidate, vertex, it.middle);
+                }
+            }
+        }
+    }
+
+    inline void ContractionHierarchy::settle(Search &side, const Search &other, const std::vector<uint64_t> &offsets,
+                                             const std::vector<Arc> &arcs,
+                                             const std::vector<uint64_t> &stall_offsets,
+                                             const std::vector<Arc> &stall_arcs, uint64_t &best, size_t &meeting) {
+        size_t vertex = side.heap.extract_min().get_value();
+        uint64_t distance = side.distances[vertex];
+        uint64_t through = saturating_add(distance, other.distances[vertex]);
+        if (through < best) {
+            best = through;
+            meeting = vertex;
+        }
+
+        if (stalled(side, vertex, stall_offsets, stall_arcs)) {
+            return;
+        }
+
+        for (uint64_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+            const auto &it = arcs[i];
+            uint64_t candidate = saturating_add<uint64_t>(distance, it.weight);
+            if (candidate < side.distances[it.target]) {
+                side.reach(it.target, candidate, vertex, it.middle);
+            }
+        }
+    }
+
+    inline uint64_t ContractionHierarchy::search(size_t source, size_t target, size_t &meeting) {
+        if (source >= ranks.size() || target >= ranks.size()) {
+            throw std::invalid_argument("nodes");
+        }
+
+        forward.reset();
+        backward.reset();
+        forward.reach(source, 0, source, hierarchy::NO_MIDDLE);
+        backward.reach(target, 0, target, hierarchy::NO_MIDDLE);
+
+        uint64_t best = INFINITE_DISTANCE;
+        meeting = source;
+        for (bool turn = true;; turn = !turn) {
+            bool forward_done = forward.heap.empty() || forward.heap.get_min().get_key() >= best;
+            bool backward_done = backward.heap.empty() || backward.heap.get_min().get_key() >= best;
+            if (forward_done && backward_done) {
+                break;
+            }
+
+            if (backward_done || (!forward_done && turn)) {
+                settle(forward, backward, upward_offsets, upward, downward_offsets, downward, best, meeting);
+            } else {
+                settle(backward, forward, downward_offsets, downward, upward_offsets, upward, best, meeting);
+            }
+        }
+        return best;
+    }
+
+    inline uint64_t ContractionHierarchy::middle_of(size_t from, size_t to) const {
+        /**
+        *  @brief The arc from -> to is stored with its lower ranked end.
+        */
+        if (ranks[from] < ranks[to]) {
+            for (uint64_t i = upward_offsets[from]; i < upward_offsets[from + 1]; ++i) {
+                if (upward[i].target == to) {
+                    return upward[i].middle;
+                }
+            }
+        } else {
+            for (uint64_t i = downward_offsets[to]; i < downward_offsets[to + 1]; ++i) {
+                if (downward[i].target == from) {
+                    return downward[i].middle;
+                }
+            }
+        }
+        throw std::logic_error("missing arc in contraction hierarchy");
+    }
+
+    inline void ContractionHierarchy::unpack(size_t from, size_t to, uint64_t middle, std::vector<size_t> &path) const {
+        /**
+        *  @brief Appends the original vertices after from up to and including to.
+        */
+        struct Piece final {
+            size_t from;
+            size_t to;
+            uint64_t middle;
+        };
+
+        std::vector<Piece> pending{{from, to, middle}};
+        while (!pending.empty()) {
+            Piece piece = pending.back();
+            pending.pop_back();
+            if (piece.middle == hierarchy::NO_MIDDLE) {
+                path.push_back(piece.to);
+                continue;
+            }
+
+            auto m = static_cast<size_t>(piece.middle);
+            pending.push_back({m, piece.to, middle_of(m, piece.to)});
+            pending.push_back({piece.from, m, middle_of(piece.from, m)});
+        }
+    }
+
+    inline Route ContractionHierarchy::route(size_t source, size_t target) {
+        size_t meeting;
+        Route result{search(source, target, meeting), {}};
+        if (result.distance == INFINITE_DISTANCE) {
+            return result;
+        }
+
+        std::vector<size_t> chain;
+        for (size_t vertex = meeting; vertex != source; vertex = forward.parents[vertex]) {
+            chain.push_back(vertex);
+        }
+
+        result.path.push_back(source);
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            unpack(forward.parents[*it], *it, forward.middles[*it], result.path);
+        }
+        for (size_t vertex = meeting; vertex != target; vertex = backward.parents[vertex]) {
+            unpack(vertex, backward.parents[vertex], backward.middles[vertex], result.path);
+        }
+        return result;
+    }
+
+    inline DistanceTable ContractionHierarchy::table(const std::vector<size_t> &sources,
+                                                     const std::vector<size_t> &targets, size_t threads) const {
+        /**
+        *  @brief Bucket-based many-to-many (Knopp et al.): one backward upward search per target leaves
+        *  (column, distance) entries in buckets at the vertices it settles, then one forward upward search
+        *  per source combines its distances with the buckets it meets. Every cell costs a bucket scan
+        *  instead of a search, and both phases run their searches in parallel.
+        */
+        size_t n = ranks.size();
+        detail::check_vertices(sources, n);
+        detail::check_vertices(targets, n);
+
+        struct Entry final {
+            size_t vertex;
+            size_t column;
+            uint64_t distance;
+        };
+
+        threads = std::max<size_t>(1, std::min(threads, std::max(sources.size(), targets.size())));
+        std::vector<Search> scratch(threads);
+        for (auto &it : scratch) {
+            it.resize(n);
+        }
+
+        std::vector<std::vector<Entry>> found(threads);
+        ThreadPool::parallel_for(targets.size(), [&](size_t column, size_t worker) {
+            sweep(scratch[worker], targets[column], false, [&](size_t vertex, uint64_t distance) {
+                found[worker].push_back({vertex, column, distance});
+            });
+        }, threads);
+
+        std::vector<size_t> offsets(n + 1, 0);
+        for (const auto &part : found) {
+            for (const auto &it : part) {
+                ++offsets[it.vertex + 1];
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<Entry> buckets(offsets[n]);
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (auto &part : found) {
+            for (const auto &it : part) {
+                buckets[fill[it.vertex]++] = it;
+            }
+            std::vector<Entry>().swap(part);
+        }
+
+        DistanceTable result(sources.size(), targets.size());
+        ThreadPool::parallel_for(sources.size(), [&](size_t row, size_t worker) {
+            sweep(scratch[worker], sources[row], true, [&](size_t vertex, uint64_t distance) {
+                for (size_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+                    auto &cell = result(row, buckets[i].column);
+                    cell = std::min<size_t>(cell, saturating_add<uint64_t>(distance, buckets[i].distance));
+                }
+            });
+        }, threads);
+        return result;
+    }
+
+    inline void ContractionHierarchy::save(const std::string &path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("failed to create contraction hierarchy file " + path);
+        }
+
+        hierarchy::HierarchyHeader header{};
+        std::memcpy(header.magic, hierarchy::MAGIC, sizeof(header.magic));
+        header.version = hierarchy::VERSION;
+        header.vertices = ranks.size();
+        header.upward_entries = upward.size();
+        header.downward_entries = downward.size();
+
+        auto write = [&out](const auto &values) {
+            out.write(reinterpret_cast<const char *>(values.data()),
+                      static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+        };
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        write(ranks);
+        write(upward_offsets);
+        write(upward);
+        write(downward_offsets);
+        write(downward);
+
+        if (!out) {
+            throw std::runtime_error("failed to write contraction hierarchy file " + path);
+        }
+    }
+
+    inline ContractionHierarchy ContractionHierarchy::load(const std::string &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("failed to open " + path);
+        }
+
+        hierarchy::HierarchyHeader header{};
+        in.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!in) {
+            throw std::runtime_error("truncated contraction hierarchy file " + path);
+        }
+        if (std::memcmp(header.magic, hierarchy::MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("not a contraction hierarchy file " + path);
+        }
+        if (header.version != hierarchy::VERSION) {
+            throw std::runtime_error("unsupported contraction hierarchy file version in " + path);
+        }
+
+        // bounded by the file size first, so no section is allocated larger than the file and the sum cannot overflow
+        in.seekg(0, std::ios::end);
+        auto size = static_cast<uint64_t>(in.tellg());
+        in.seekg(sizeof(header), std::ios::beg);
+        uint64_t words = (size - sizeof(header)) / sizeof(uint64_t);
+        uint64_t arcs = (size - sizeof(header)) / sizeof(Arc);
+        if (!in || header.vertices >= words / 3 || header.upward_entries > arcs || header.downward_entries > arcs ||
+            sizeof(header) + (3 * header.vertices + 2) * sizeof(uint64_t) +
+            (header.upward_entries + header.downward_entries) * sizeof(Arc) > size) {
+            throw std::runtime_error("truncated contraction hierarchy file " + path);
+        }
+
+        ContractionHierarchy result;
+        auto read = [&in, &path](auto &values, uint64_t count) {
+            values.resize(count);
+            in.read(reinterpret_cast<char *>(values.data()),
+                    static_cast<std::streamsize>(count * sizeof(values[0])));
+            if (!in) {
+                throw std::runtime_error("truncated contraction hierarchy file " + path);
+            }
+        };
+        read(result.ranks, header.vertices);
+        read(result.upward_offsets, header.vertices + 1);
+        read(result.upward, header.upward_entries);
+        read(result.downward_offsets, header.vertices + 1);
+        read(result.downward, header.downward_entries);
+
+        std::vector<char> seen(header.vertices, 0);
+        for (const auto &it : result.ranks) {
+            if (it >= header.vertices || seen[it]) {
+                throw std::runtime_error("corrupted ranks in contraction hierarchy file " + path);
+            }
+            seen[it] = 1;
+        }
+
+        /**
+        *  Both arc lists are stored with their lower ranked end, and a shortcut bypasses a vertex ranked below
+        *  both of its ends; queries and unpacking rely on that to stay in bounds and to terminate.
+        */
+        const auto &ranks = result.ranks;
+        auto check = [&](const std::vector<uint64_t> &offsets, const std::vector<Arc> &arcs, uint64_t entries) {
+            if (offsets[0] != 0 || offsets[header.vertices] != entries) {
+                throw std::runtime_error("corrupted offsets in contraction hierarchy file " + path);
+            }
+            for (size_t v = 0; v < header.vertices; ++v) {
+                if (offsets[v] > offsets[v + 1]) {
+                    throw std::runtime_error("corrupted offsets in contraction hierarchy file " + path);
+                }
+            }
+            for (size_t v = 0; v < header.vertices; ++v) {
+                for (uint64_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+                    const auto &it = arcs[i];
+                    if (it.target >= header.vertices || ranks[it.target] <= ranks[v] ||
+                        (it.middle != hierarchy::NO_MIDDLE && (it.middle >= header.vertices ||
+                                                               ranks[it.middle] >= ranks[v]))) {
+                        throw std::runtime_error("corrupted arcs in contraction hierarchy file " + path);
+                    }
+                }
+            }
+        };
+        check(result.upward_offsets, result.upward, header.upward_entries);
+        check(result.downward_offsets, result.downward, header.downward_entries);
+
+        result.forward.resize(header.vertices);
+        result.backward.resize(header.vertices);
+        return result;
+    }
+
+    template<typename G>
+    ContractionHierarchy contract(const G &g) {
+        /**
+        *  @brief Preprocesses g; save() the result and load() it instead of contracting the same graph again.
+        */
+        return ContractionHierarchy(g);
+    }
+}
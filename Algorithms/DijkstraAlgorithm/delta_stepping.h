@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+#include "dijkstra.h"
+
+
+namespace ShortestPaths {
+    template<typename G>
+    class DeltaStepping final {
+        /**
+        *  @brief Delta-stepping SSSP (Meyer, Sanders). Tentative distances are kept in buckets of width delta;
+        *  the lowest bucket is emptied by repeated parallel rounds over its light edges (weight <= delta),
+        *  after which the heavy edges of everything it settled are relaxed in one more parallel round.
+        *  delta == 1 behaves like Dijkstra with a bucket queue, a huge delta like Bellman-Ford.
+        *  Produces the same distances as dijkstra(); parents are picked among tight edges afterwards.
+        */
+        static constexpr size_t GRAIN = 1024;       // smaller rounds stay on the calling thread
+
+        struct alignas(64) Worker final {
+            std::vector<size_t> requests;
+        };
+
+        const G &g;
+        size_t threads;
+        size_t max_weight;
+        bool zero_weights;
+        size_t delta;
+
+        std::vector<std::atomic<size_t>> distances;
+        std::vector<std::atomic<size_t>> parents;
+        std::vector<std::vector<size_t>> buckets;   // cyclic, every queued distance is within max_weight
+        std::vector<size_t> queued;                 // absolute bucket a vertex was last put into
+        std::vector<size_t> processed;              // absolute bucket a vertex was last settled in
+        std::vector<size_t> frontier;
+        std::vector<size_t> settled;
+        std::vector<Worker> workers;
+
+        size_t workers_for(size_t work) const {
+            return std::max<size_t>(1, std::min(threads, work / GRAIN));
+        };
+
+        void enqueue(size_t vertex);
+
+        template<bool Light>
+        void relax(const std::vector<size_t> &sources);
+
+        void find_parents(size_t source);
+
+    public:
+        explicit DeltaStepping(const G &new_g, size_t new_delta = 0,
+                               size_t new_threads = ThreadPool::default_threads());
+
+        [[nodiscard]] size_t get_delta() const {
+            return delta;
+        };
+
+        ShortestPathTree run(size_t source);
+    };
+
+    template<typename G>
+    DeltaStepping<G>::DeltaStepping(const G &new_g, size_t new_delta, size_t new_threads) :
+            g(new_g), threads(std::max<size_t>(1, new_threads)), max_weight(0), zero_weights(false),
+            delta(new_delta), distances(new_g.number_of_vertices()), parents(new_g.number_of_vertices()),
+            workers(threads) {
+        size_t entries = 0;
+        for (const auto &row : g) {
+            for (const auto &it : row) {
+                size_t weight = graph::weight_of(it);
+                max_weight = std::max(max_weight, weight);
+                zero_weights = zero_weights || weight == 0;
+            }
+            entries += row.size();
+        }
+
+        if (delta == 0) {       // Meyer-Sanders: about the largest weight over the average degree
+            size_t degree = std::max<size_t>(1, entries / std::max<size_t>(1, g.number_of_vertices()));
+            delta = std::max<size_t>(1, max_weight / degree);
+        }
+        buckets.resize(max_weight / delta + 2);
+    }
+
+    template<typename G>
+    void DeltaStepping<G>::enqueue(size_t vertex) {
+        size_t bucket = distances[vertex].load(std::memory_order_relaxed) / delta;
+        if (queued[vertex] != bucket) {
+            queued[vertex] = bucket;
+            buckets[bucket % buckets.size()].push_back(vertex);
+        }
+    }
+
+    template<typename G>
+    template<bool Light>
+    void DeltaStepping<G>::relax(const std::vector<size_t> &sources) {
+        ThreadPool::parallel_for(sources.size(), [this, &sources](size_t i, size_t worker) {
+            size_t source = sources[i];
+            size_t distance = distances[source].load(std::memory_order_relaxed);
+            for (const auto &it : g[source]) {
+                size_t weight = graph::weight_of(it);
+                if ((weight <= delta) != Light) {
+                    continue;
+                }
+
+                size_t target = graph::target_of(it);
+                size_t candidate = saturating_add(distance, weight);
+                size_t current = distances[target].load(std::memory_order_relaxed);
+                while (candidate < current) {
+                    if (distances[target].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                        workers[worker].requests.push_back(target);
+                        break;
+                    }
+                }
+            }
+        }, workers_for(sources.size()));
+
+        for (auto &it : workers) {
+            for (const auto &vertex : it.requests) {
+                enqueue(vertex);
+            }
+            it.requests.clear();
+        }
+    }
+
+    template<typename G>
+    void DeltaStepping<G>::find_parents(size_t source) {
+        /**
+        *  @brief Any edge with distances[u] + w == distances[v] is a valid last step to v. Zero-weight edges
+        *  could close a cycle that way, so they are only followed from vertices that already have a parent.
+        */
+        size_t n = g.number_of_vertices();
+        for (auto &it : parents) {
+            it.store(INFINITE_DISTANCE, std::memory_order_relaxed);
+        }
+        parents[source].store(source, std::memory_order_relaxed);
+
+        ThreadPool::parallel_for(n, [this, source](size_t vertex, size_t) {
+            size_t distance = distances[vertex].load(std::memory_order_relaxed);
+            if (distance == INFINITE_DISTANCE) {
+                return;
+            }
+            for (const auto &it : g[vertex]) {
+                size_t target = graph::target_of(it);
+                size_t weight = graph::weight_of(it);
+                size_t candidate = saturating_add(distance, weight);
+                if (weight == 0 || target == source || candidate == INFINITE_DISTANCE ||
+                    candidate != distances[target].load(std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                size_t expected = INFINITE_DISTANCE;
+                parents[target].compare_exchange_strong(expected, vertex, std::memory_order_relaxed);
+            }
+        }, workers_for(n));
+
+        if (!zero_weights) {
+            return;
+        }
+
+        frontier.clear();
+        for (size_t i = 0; i < n; ++i) {
+            if (parents[i].load(std::memory_order_relaxed) != INFINITE_DISTANCE) {
+                frontier.push_back(i);
+            }
+        }
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            size_t vertex = frontier[head];
+            size_t distance = distances[vertex].load(std::memory_order_relaxed);
+            for (const auto &it : g[vertex]) {
+                size_t target = graph::target_of(it);
+                if (graph::weight_of(it) == 0 && distances[target].load(std::memory_order_relaxed) == distance &&
+                    parents[target].load(std::memory_order_relaxed) == INFINITE_DISTANCE) {
+                    parents[target].store(vertex, std::memory_order_relaxed);
+                    frontier.push_back(target);
+                }
+            }
+        }
+    }
+
+    template<typename G>
+    ShortestPathTree DeltaStepping<G>::run(size_t source) {
+        size_t n = g.number_of_vertices();
+        if (source >= n) {
+            throw std::invalid_argument("start position");
+        }
+
+        for (auto &it : distances) {
+            it.store(INFINITE_DISTANCE, std::memory_order_relaxed);
+        }
+        queued.assign(n, INFINITE_DISTANCE);
+        processed.assign(n, INFINITE_DISTANCE);
+        for (auto &it : buckets) {
+            it.clear();
+        }
+
+        distances[source].store(0, std::memory_order_relaxed);
+        enqueue(source);
+
+        std::vector<size_t> round;
+        for (size_t current = 0;; ++current) {
+            size_t skipped = 0;
+            while (skipped < buckets.size() && buckets[current % buckets.size()].empty()) {
+                ++current;
+                ++skipped;
+            }
+            if (skipped == buckets.size()) {
+                break;
+            }
+
+            auto &bucket = buckets[current % buckets.size()];
+            settled.clear();
+            while (!bucket.empty()) {
+                round.clear();
+                round.swap(bucket);
+
+                frontier.clear();
+                for (const auto &it : round) {
+                    if (queued[it] == current) {        // otherwise the vertex has moved to a lower bucket
+                        queued[it] = INFINITE_DISTANCE;
+                        frontier.push_back(it);
+                        if (processed[it] != current) {
+                            processed[it] = current;
+                            settled.push_back(it);
+                        }
+                    }
+                }
+                relax<true>(frontier);
+            }
+            relax<false>(settled);
+        }
+
+        find_parents(source);
+
+        ShortestPathTree result;
+        result.distances.resize(n);
+        result.parents.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.distances[i] = distances[i].load(std::memory_order_relaxed);
+            result.parents[i] = parents[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    template<typename G>
+    ShortestPathTree delta_stepping(const G &g, size_t source, size_t delta = 0,
+                                    size_t threads = ThreadPool::default_threads()) {
+        /**
+        *  @brief One-shot delta-stepping; delta == 0 picks the largest weight over the average degree.
+        */
+        static_assert(graph::is_graph_v<G>, "delta_stepping expects a graph");
+        return DeltaStepping<G>(g, delta, threads).run(source);
+    }
+}
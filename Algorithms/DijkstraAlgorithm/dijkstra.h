@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/binary_heap/binary_heap.h"
+#include "../../DataStructures/bucket_queue/bucket_queue.h"
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/radix_heap/radix_heap.h"
+#include "distance.h"
+
+
+namespace ShortestPaths {
+    struct ShortestPathTree final {
+        std::vector<size_t> distances;      // INFINITE_DISTANCE if there is no path
+        std::vector<size_t> parents;        // previous vertex on a shortest path, the source is its own parent
+    };
+
+    enum class Queue {
+        BINARY_HEAP,        // any weights, O((V + E) log V)
+        RADIX_HEAP,         // O(E + V log C) for the largest weight C
+        BUCKET_QUEUE        // Dial, O(E + V * C), small integer weights only: C above MAX_SPAN throws
+    };
+
+    namespace detail {
+        template<Queue Q>
+        struct queue_type;
+
+        template<>
+        struct queue_type<Queue::BINARY_HEAP> {
+            using type = BinaryHeap::IndexedBinaryHeap<size_t>;
+        };
+
+        template<>
+        struct queue_type<Queue::RADIX_HEAP> {
+            using type = RadixHeap::RadixHeap<size_t>;
+        };
+
+        template<>
+        struct queue_type<Queue::BUCKET_QUEUE> {
+            using type = BucketQueue::BucketQueue<size_t>;
+        };
+
+        template<typename G>
+        size_t max_weight(const G &g) {
+            size_t result = 0;
+            for (const auto &row : g) {
+                for (const auto &it : row) {
+                    result = std::max(result, graph::weight_of(it));
+                }
+            }
+            return result;
+        }
+
+        template<Queue Q, typename G>
+        typename queue_type<Q>::type make_queue(const G &g) {
+            if constexpr (Q == Queue::BUCKET_QUEUE) {
+                return typename queue_type<Q>::type(g.number_of_vertices(), max_weight(g));
+            } else {
+                return typename queue_type<Q>::type(g.number_of_vertices());
+            }
+        }
+    }
+
+    template<Queue Q = Queue::BINARY_HEAP, typename G>
+    ShortestPathTree dijkstra(const G &g, size_t source) {
+        /**
+        *  @brief Single-source shortest paths for non-negative weights: every vertex enters the queue once and
+        *  improvements decrease its key in place. The queue is chosen at compile time, the integer queues rely
+        *  on Dijkstra extracting keys in non-decreasing order.
+        */
+        static_assert(graph::is_graph_v<G>, "dijkstra expects a graph");
+
+        size_t n = g.number_of_vertices();
+        if (source >= n) {
+            throw std::invalid_argument("start position");
+        }
+
+        ShortestPathTree result;
+        result.distances.assign(n, INFINITE_DISTANCE);
+        result.parents.assign(n, INFINITE_DISTANCE);
+        result.distances[source] = 0;
+        result.parents[source] = source;
+
+        auto heap = detail::make_queue<Q>(g);
+        heap.insert(0, source);
+        while (!heap.empty()) {
+            auto node = heap.extract_min();
+            size_t vertex = node.get_value();
+            size_t distance = node.get_key();
+
+            for (const auto &it : g[vertex]) {
+                size_t target = graph::target_of(it);
+                size_t candidate = saturating_add(distance, graph::weight_of(it));
+                if (candidate < result.distances[target]) {
+                    result.distances[target] = candidate;
+                    result.parents[target] = vertex;
+                    heap.insert_or_decrease(candidate, target);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    inline std::vector<size_t> path(const std::vector<size_t> &parents, size_t target) {
+        /**
+        *  @brief Vertices from the source to target along a parents array of dijkstra or bfs,
+        *  empty if target was not reached.
+        */
+        if (target >= parents.size()) {
+            throw std::invalid_argument("target position");
+        }
+
+        std::vector<size_t> result;
+        if (parents[target] == INFINITE_DISTANCE) {
+            return result;
+        }
+
+        result.push_back(target);
+        while (parents[result.back()] != result.back()) {
+            result.push_back(parents[result.back()]);
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+
+namespace ShortestPaths {
+    constexpr size_t INFINITE_DISTANCE = std::numeric_limits<size_t>::max();
+
+    template<typename T>
+    constexpr T saturating_add(T lhs, T rhs) {
+        /**
+        *  @brief lhs + rhs, or the largest value of T if that overflows. Without branches: the wrapped sum is
+        *  smaller than lhs exactly when it overflowed, and negating that bit gives an all-ones mask.
+        */
+        static_assert(std::is_unsigned<T>::value, "saturating_add expects unsigned integers");
+        T sum = static_cast<T>(lhs + rhs);
+        return static_cast<T>(sum | static_cast<T>(-static_cast<T>(sum < lhs)));
+    }
+
+    template<typename T>
+    class Distance final {
+        /**
+        *  @brief Path length where the largest value of T means no path. Addition saturates there, so
+        *  infinity plus anything stays infinity, and comparisons are the plain integer ones because infinity
+        *  is already the largest value. Same size and layout as T, so arrays of it are plain integer arrays.
+        */
+        static_assert(std::is_unsigned<T>::value, "distances are unsigned integers");
+
+        T value;
+
+    public:
+        static constexpr T INFINITE = std::numeric_limits<T>::max();
+
+        constexpr Distance() : value(INFINITE) {};
+
+        constexpr explicit Distance(T new_value) : value(new_value) {};
+
+        [[nodiscard]] constexpr T get() const {
+            return value;
+        };
+
+        [[nodiscard]] constexpr bool is_infinite() const {
+            return value == INFINITE;
+        };
+
+        constexpr Distance &operator +=(const Distance &other) {
+            value = saturating_add(value, other.value);
+            return *this;
+        };
+
+        constexpr Distance &operator +=(T other) {
+            value = saturating_add(value, other);
+            return *this;
+        };
+
+        friend constexpr Distance operator +(Distance lhs, const Distance &rhs) {
+            return lhs += rhs;
+        };
+
+        friend constexpr Distance operator +(Distance lhs, T rhs) {
+            return lhs += rhs;
+        };
+
+        friend constexpr bool operator ==(const Distance &lhs, const Distance &rhs) {
+            return lhs.value == rhs.value;
+        };
+
+        friend constexpr bool operator !=(const Distance &lhs, const Distance &rhs) {
+            return lhs.value != rhs.value;
+        };
+
+        friend constexpr bool operator <(const Distance &lhs, const Distance &rhs) {
+            return lhs.value < rhs.value;
+        };
+
+        friend constexpr bool operator <=(const Distance &lhs, const Distance &rhs) {
+            return lhs.value <= rhs.value;
+        };
+
+        friend constexpr bool operator >(const Distance &lhs, const Distance &rhs) {
+            return lhs.value > rhs.value;
+        };
+
+        friend constexpr bool operator >=(const Distance &lhs, const Distance &rhs) {
+            return lhs.value >= rhs.value;
+        };
+    };
+
+    static_assert(sizeof(Distance<size_t>) == sizeof(size_t) && std::is_trivially_copyable<Distance<size_t>>::value,
+                  "Distance must stay a plain integer in memory");
+
+    template<typename T>
+    std::ostream &operator<<(std::ostream &os, const Distance<T> &distance) {
+        if (distance.is_infinite()) {
+            return os << -1;
+        }
+        return os << distance.get();
+    }
+}
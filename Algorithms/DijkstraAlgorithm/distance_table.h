@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/binary_heap/binary_heap.h"
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+#include "dijkstra.h"
+
+
+namespace ShortestPaths {
+    struct DistanceTable final {
+        size_t rows;
+        size_t columns;
+        std::vector<size_t> distances;      // row-major, INFINITE_DISTANCE if there is no path
+
+        DistanceTable() : rows(0), columns(0) {};
+
+        DistanceTable(size_t new_rows, size_t new_columns) : rows(new_rows), columns(new_columns),
+                                                             distances(new_rows * new_columns, INFINITE_DISTANCE) {};
+
+        size_t &operator ()(size_t row, size_t column) {
+            return distances[row * columns + column];
+        };
+
+        const size_t &operator ()(size_t row, size_t column) const {
+            return distances[row * columns + column];
+        };
+    };
+
+    namespace detail {
+        inline void check_vertices(const std::vector<size_t> &vertices, size_t n) {
+            for (const auto &it : vertices) {
+                if (it >= n) {
+                    throw std::invalid_argument("invalid vertices");
+                }
+            }
+        }
+    }
+
+    template<typename G>
+    class ManyToMany final {
+        /**
+        *  @brief Distance tables by one Dijkstra per source, sources spread over threads. Every worker keeps
+        *  its own distances and heap for the lifetime of the engine and resets only what a search touched;
+        *  a search stops as soon as all targets are settled. For many queries on a static graph
+        *  ContractionHierarchy::table shares the work between sources instead.
+        */
+        struct alignas(64) Worker final {
+            std::vector<size_t> distances;
+            std::vector<size_t> touched;
+            BinaryHeap::IndexedBinaryHeap<size_t> heap;
+        };
+
+        const G &g;
+        size_t threads;
+        std::vector<Worker> workers;
+        std::vector<size_t> wanted;     // distinct targets of the current table that are this vertex
+
+        void search(Worker &worker, size_t source, size_t remaining);
+
+    public:
+        explicit ManyToMany(const G &new_g, size_t new_threads = ThreadPool::default_threads());
+
+        DistanceTable run(const std::vector<size_t> &sources, const std::vector<size_t> &targets);
+    };
+
+    template<typename G>
+    ManyToMany<G>::ManyToMany(const G &new_g, size_t new_threads) : g(new_g),
+                                                                    threads(std::max<size_t>(1, new_threads)),
+                                                                    wanted(new_g.number_of_vertices(), 0) {
+        static_assert(graph::is_graph_v<G>, "ManyToMany expects a graph");
+    }
+
+    template<typename G>
+    void ManyToMany<G>::search(Worker &worker, size_t source, size_t remaining) {
+        for (const auto &it : worker.touched) {
+            worker.distances[it] = INFINITE_DISTANCE;
+        }
+        worker.touched.clear();
+        worker.heap.clear();
+
+        worker.distances[source] = 0;
+        worker.touched.push_back(source);
+        worker.heap.insert(0, source);
+        while (!worker.heap.empty() && remaining) {
+            auto node = worker.heap.extract_min();
+            size_t vertex = node.get_value();
+            remaining -= wanted[vertex];
+
+            for (const auto &it : g[vertex]) {
+                size_t target = graph::target_of(it);
+                size_t candidate = saturating_add(node.get_key(), graph::weight_of(it));
+                if (candidate < worker.distances[target]) {
+                    if (worker.distances[target] == INFINITE_DISTANCE) {
+                        worker.touched.push_back(target);
+                    }
+                    worker.distances[target] = candidate;
+                    worker.heap.insert_or_decrease(candidate, target);
+                }
+            }
+        }
+    }
+
+    template<typename G>
+    DistanceTable ManyToMany<G>::run(const std::vector<size_t> &sources, const std::vector<size_t> &targets) {
+        size_t n = g.number_of_vertices();
+        detail::check_vertices(sources, n);
+        detail::check_vertices(targets, n);
+
+        size_t count = std::max<size_t>(1, std::min(threads, sources.size()));
+        if (workers.size() < count) {
+            workers.resize(count);
+        }
+        for (auto &it : workers) {
+            if (it.distances.size() != n) {
+                it.distances.assign(n, INFINITE_DISTANCE);
+                it.heap.resize(n);
+            }
+        }
+
+        size_t distinct = 0;
+        for (const auto &it : targets) {
+            if (!wanted[it]) {
+                wanted[it] = 1;
+                ++distinct;
+            }
+        }
+
+        auto release = [this, &targets] {
+            for (const auto &it : targets) {
+                wanted[it] = 0;
+            }
+        };
+
+        DistanceTable result;
+        try {
+            result = DistanceTable(sources.size(), targets.size());
+            ThreadPool::parallel_for(sources.size(), [&](size_t i, size_t worker) {
+                search(workers[worker], sources[i], distinct);
+                for (size_t j = 0; j < targets.size(); ++j) {
+                    result(i, j) = workers[worker].distances[targets[j]];
+                }
+            }, count);
+        } catch (...) {
+            release();      // stale marks would end the searches of the next table early
+            throw;
+        }
+
+        release();
+        return result;
+    }
+
+    template<typename G>
+    DistanceTable distance_table(const G &g, const std::vector<size_t> &sources, const std::vector<size_t> &targets,
+                                 size_t threads = ThreadPool::default_threads()) {
+        /**
+        *  @brief One-shot table, rows follow sources and columns follow targets.
+        */
+        return ManyToMany<G>(g, threads).run(sources, targets);
+    }
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../../DataStructures/binary_heap/binary_heap.h"
+#include "../../DataStructures/graph/graph.h"
+#include "dijkstra.h"
+
+
+namespace ShortestPaths {
+    template<typename N>
+    struct EdgeBatch final {
+        std::vector<std::pair<size_t, N>> insertions;      // (source, node) as taken by add_edges
+        std::vector<std::pair<size_t, N>> deletions;       // (source, node) as taken by remove_edges
+    };
+
+    template<typename G>
+    class DynamicShortestPaths final {
+        /**
+        *  @brief Single-source distances and shortest-path tree kept up to date while the graph changes
+        *  (Ramalingam, Reps). Edge updates go through apply(), which changes the graph and then repairs:
+        *  a deleted tree edge invalidates the subtree below it, whose vertices are re-seeded from their
+        *  unaffected in-neighbours; an inserted edge that shortens a path seeds its target. One Dijkstra run
+        *  from all seeds then settles only vertices whose distance or parent can change.
+        *  Directed graphs need incoming edges, which are mirrored here; the graph must not be modified
+        *  other than through apply() or by appending vertices.
+        */
+        using node_type = typename G::node_type;
+
+        G &g;
+        size_t source;
+        bool directed;
+        std::vector<size_t> distances;
+        std::vector<size_t> parents;
+        std::vector<std::vector<std::pair<size_t, size_t>>> incoming;     // (source, weight), directed only
+        std::vector<char> affected;
+        std::vector<size_t> region;
+        BinaryHeap::IndexedBinaryHeap<size_t> heap;
+        size_t settled;
+
+        size_t grow();
+
+        void check(const std::vector<std::pair<size_t, node_type>> &edges) const;
+
+        void seed(size_t vertex, size_t distance, size_t parent) {
+            distances[vertex] = distance;
+            parents[vertex] = parent;
+            heap.insert_or_decrease(distance, vertex);
+        };
+
+        void try_edge(size_t from, size_t to, size_t weight) {
+            size_t candidate = saturating_add(distances[from], weight);
+            if (candidate < distances[to]) {
+                seed(to, candidate, from);
+            }
+        };
+
+        void cut(size_t from, size_t to);
+
+        void reseed();
+
+        void propagate();
+
+    public:
+        DynamicShortestPaths(G &new_g, size_t new_source);
+
+        void apply(const EdgeBatch<node_type> &batch);
+
+        void insert_edge(size_t from, const node_type &to) {
+            apply({{{from, to}}, {}});
+        };
+
+        void remove_edge(size_t from, const node_type &to) {
+            apply({{}, {{from, to}}});
+        };
+
+        [[nodiscard]] size_t get_source() const {
+            return source;
+        };
+
+        [[nodiscard]] const std::vector<size_t> &get_distances() const {
+            return distances;
+        };
+
+        [[nodiscard]] const std::vector<size_t> &get_parents() const {
+            return parents;
+        };
+
+        [[nodiscard]] size_t last_settled() const {
+            return settled;
+        };
+    };
+
+    template<typename G>
+    DynamicShortestPaths<G>::DynamicShortestPaths(G &new_g, size_t new_source) :
+            g(new_g), source(new_source), directed(graph::is_directed(new_g)), settled(0) {
+        static_assert(graph::is_graph_v<G>, "DynamicShortestPaths expects a graph");
+
+        if (source >= g.number_of_vertices()) {
+            throw std::invalid_argument("start position");
+        }
+
+        grow();
+        seed(source, 0, source);
+        propagate();
+    }
+
+    template<typename G>
+    size_t DynamicShortestPaths<G>::grow() {
+        /**
+        *  @brief Picks up vertices appended to the graph since the last update and mirrors their edges into
+        *  incoming. They start unreached; returns the first of them, so that undirected ones can be seeded
+        *  from their neighbours once the repair of deletions is done.
+        */
+        size_t n = g.number_of_vertices(), first = distances.size();
+        if (n == first) {
+            return first;
+        }
+
+        distances.resize(n, INFINITE_DISTANCE);
+        parents.resize(n, INFINITE_DISTANCE);
+        affected.resize(n, 0);
+        heap.resize(n);
+        if (directed) {
+            incoming.resize(n);
+            for (size_t i = first; i < n; ++i) {
+                for (const auto &it : g[i]) {
+                    incoming[graph::target_of(it)].emplace_back(i, graph::weight_of(it));
+                }
+            }
+        }
+        return first;
+    }
+
+    template<typename G>
+    void DynamicShortestPaths<G>::check(const std::vector<std::pair<size_t, node_type>> &edges) const {
+        for (const auto &it : edges) {
+            if (it.first >= distances.size() || graph::target_of(it.second) >= distances.size()) {
+                throw std::invalid_argument("invalid vertices");
+            }
+        }
+    }
+
+    template<typename G>
+    void DynamicShortestPaths<G>::cut(size_t from, size_t to) {
+        /**
+        *  @brief The edge from -> to is gone; if it was the tree edge of to, its whole subtree is affected.
+        *  A parallel edge may still give the same distance, the re-seeding finds it then.
+        */
+        if (to == source || parents[to] != from || affected[to]) {
+            return;
+        }
+
+        size_t head = region.size();
+        affected[to] = 1;
+        region.push_back(to);
+        for (; head < region.size(); ++head) {
+            size_t vertex = region[head];
+            for (const auto &it : g[vertex]) {
+                size_t child = graph::target_of(it);
+                if (parents[child] == vertex && !affected[child] && child != source) {
+                    affected[child] = 1;
+                    region.push_back(child);
+                }
+            }
+        }
+    }
+
+    template<typename G>
+    void DynamicShortestPaths<G>::reseed() {
+        /**
+        *  @brief Forgets the distances of the affected region and seeds each of its vertices with the best
+        *  edge from outside the region, whose distances are still exact.
+        */
+        for (const auto &it : region) {
+            distances[it] = INFINITE_DISTANCE;
+            parents[it] = INFINITE_DISTANCE;
+        }
+
+        for (const auto &vertex : region) {
+            auto consider = [this, vertex](size_t from, size_t weight) {
+                if (!affected[from]) {
+                    try_edge(from, vertex, weight);
+                }
+            };
+            if (directed) {
+                for (const auto &it : incoming[vertex]) {
+                    consider(it.first, it.second);
+                }
+            } else {
+                for (const auto &it : g[vertex]) {
+                    consider(graph::target_of(it), graph::weight_of(it));
+                }
+            }
+        }
+
+        for (const auto &it : region) {
+            affected[it] = 0;
+        }
+        region.clear();
+    }
+
+    template<typename G>
+    void DynamicShortestPaths<G>::propagate() {
+        settled = 0;
+        while (!heap.empty()) {
+            size_t vertex = heap.extract_min().get_value();
+            ++settled;
+            for (const auto &it : g[vertex]) {
+                try_edge(vertex, graph::target_of(it), graph::weight_of(it));
+            }
+        }
+    }
+
+    template<typename G>
+    void DynamicShortestPaths<G>::apply(const EdgeBatch<node_type> &batch) {
+        /**
+        *  @brief Applies the whole batch to the graph, then repairs once: deletions first, since they can only
+        *  lengthen paths, then insertions, which can only shorten them.
+        */
+        size_t appended = grow();
+        check(batch.insertions);
+        check(batch.deletions);
+
+        for (const auto &it : batch.deletions) {
+            size_t from = it.first, to = graph::target_of(it.second);
+            size_t before = g.number_of_edges();
+            g.remove_edge(from, it.second);
+            if (g.number_of_edges() == before) {
+                continue;       // there was no such edge
+            }
+
+            if (directed) {
+                auto &list = incoming[to];
+                auto entry = std::find(list.begin(), list.end(), std::make_pair(from, graph::weight_of(it.second)));
+                if (entry != list.end()) {
+                    *entry = list.back();
+                    list.pop_back();
+                }
+            }
+            cut(from, to);
+            if (!directed) {
+                cut(to, from);
+            }
+        }
+        reseed();
+
+        if (!directed) {        // the edges of appended vertices are insertions into existing rows too
+            for (size_t v = appended, n = g.number_of_vertices(); v < n; ++v) {
+                for (const auto &it : g[v]) {
+                    try_edge(graph::target_of(it), v, graph::weight_of(it));
+                }
+            }
+        }
+        g.add_edges(batch.insertions.begin(), batch.insertions.end());
+        for (const auto &it : batch.insertions) {
+            size_t from = it.first, to = graph::target_of(it.second), weight = graph::weight_of(it.second);
+            if (directed) {
+                incoming[to].emplace_back(from, weight);
+            }
+            try_edge(from, to, weight);
+            if (!directed) {
+                try_edge(to, from, weight);
+            }
+        }
+
+        propagate();
+    }
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../../DataStructures/graph/csr_graph.h"
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+#include "dijkstra.h"
+#include "point_to_point.h"
+
+
+namespace ShortestPaths {
+    enum class LandmarkSelection {
+        FARTHEST,       // each landmark as far as possible from the ones already picked
+        DEGREE          // the best connected vertices
+    };
+
+    template<typename G, typename T = uint32_t>
+    class LandmarkOracle final {
+        /**
+        *  @brief ALT (A*, landmarks, triangle inequality; Goldberg, Harrelson). Distances from and to k
+        *  landmarks bound every distance: d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L) give
+        *  lower bounds for A*, d(s, L) + d(L, t) gives a cheap upper bound usable as an approximate answer.
+        *  Tables are stored vertex-major as T, scaled down when distances do not fit; with a scale above one
+        *  the bounds are widened by one unit of scale so that they stay valid.
+        */
+        static_assert(std::is_unsigned<T>::value, "landmark tables hold unsigned integers");
+
+        static constexpr T UNKNOWN = std::numeric_limits<T>::max();
+
+        const G &g;
+        size_t threads;
+        std::vector<size_t> landmarks;
+        size_t scale;
+        std::vector<T> from_landmarks;      // from_landmarks[v * k + i] = d(landmarks[i], v) / scale
+        std::vector<T> to_landmarks;        // to_landmarks[v * k + i] = d(v, landmarks[i]) / scale
+        PointToPoint<G> search;
+
+        void select(size_t count, LandmarkSelection selection, std::vector<std::vector<size_t>> &forward);
+
+        void store(const std::vector<std::vector<size_t>> &forward, const std::vector<std::vector<size_t>> &backward);
+
+        void check(size_t source, size_t target) const {
+            if (source >= g.number_of_vertices() || target >= g.number_of_vertices()) {
+                throw std::invalid_argument("nodes");
+            }
+        };
+
+    public:
+        LandmarkOracle(const G &new_g, size_t count, LandmarkSelection selection = LandmarkSelection::FARTHEST,
+                       size_t new_threads = ThreadPool::default_threads());
+
+        [[nodiscard]] const std::vector<size_t> &get_landmarks() const {
+            return landmarks;
+        };
+
+        [[nodiscard]] size_t get_scale() const {
+            return scale;
+        };
+
+        [[nodiscard]] size_t lower_bound(size_t vertex, size_t target) const;
+
+        [[nodiscard]] size_t upper_bound(size_t source, size_t target) const;
+
+        [[nodiscard]] size_t approximate(size_t source, size_t target) const {
+            return upper_bound(source, target);
+        };
+
+        Route route(size_t source, size_t target);
+    };
+
+    template<typename G, typename T>
+    LandmarkOracle<G, T>::LandmarkOracle(const G &new_g, size_t count, LandmarkSelection selection,
+                                         size_t new_threads) : g(new_g),
+                                                               threads(std::max<size_t>(1, new_threads)),
+                                                               scale(1), search(new_g) {
+        static_assert(graph::is_graph_v<G>, "LandmarkOracle expects a graph");
+
+        size_t n = g.number_of_vertices();
+        if (count == 0 || count > n) {
+            throw std::invalid_argument("number of landmarks");
+        }
+
+        std::vector<std::vector<size_t>> forward;
+        select(count, selection, forward);
+
+        std::vector<std::vector<size_t>> backward(count);
+        if (graph::is_directed(g)) {
+            const auto reverse = graph::transpose(g);
+            ThreadPool::parallel_for(count, [&](size_t i, size_t) {
+                backward[i] = dijkstra(reverse, landmarks[i]).distances;
+            }, threads);
+        } else {
+            backward = forward;
+        }
+
+        store(forward, backward);
+    }
+
+    template<typename G, typename T>
+    void LandmarkOracle<G, T>::select(size_t count, LandmarkSelection selection,
+                                      std::vector<std::vector<size_t>> &forward) {
+        size_t n = g.number_of_vertices();
+        if (selection == LandmarkSelection::DEGREE) {
+            std::vector<size_t> degrees(n, 0);
+            for (size_t i = 0; i < n; ++i) {
+                degrees[i] += g[i].size();
+                for (const auto &it : g[i]) {
+                    ++degrees[graph::target_of(it)];
+                }
+            }
+
+            std::vector<size_t> order(n);
+            for (size_t i = 0; i < n; ++i) {
+                order[i] = i;
+            }
+            std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(count), order.end(),
+                              [&degrees](size_t a, size_t b) {
+                                  return degrees[a] > degrees[b] || (degrees[a] == degrees[b] && a < b);
+                              });
+            landmarks.assign(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(count));
+
+            forward.resize(count);
+            ThreadPool::parallel_for(count, [&](size_t i, size_t) {
+                forward[i] = dijkstra(g, landmarks[i]).distances;
+            }, threads);
+            return;
+        }
+
+        /**
+        *  Farthest-point: every step runs Dijkstra from the newest landmark and picks the vertex whose
+        *  distance to the nearest landmark is largest; INFINITE_DISTANCE being the largest value, vertices
+        *  no landmark reaches yet come first.
+        */
+        std::vector<size_t> nearest(n, INFINITE_DISTANCE);
+        std::vector<char> chosen(n, 0);
+        size_t next = 0;
+        for (size_t i = 1; i < n; ++i) {
+            if (g[i].size() > g[next].size()) {
+                next = i;
+            }
+        }
+
+        while (landmarks.size() < count) {
+            landmarks.push_back(next);
+            chosen[next] = 1;
+            forward.push_back(dijkstra(g, next).distances);
+
+            bool found = false;
+            for (size_t i = 0; i < n; ++i) {
+                nearest[i] = std::min(nearest[i], forward.back()[i]);
+                if (!chosen[i] && (!found || nearest[i] > nearest[next])) {
+                    found = true;
+                    next = i;
+                }
+            }
+        }
+    }
+
+    template<typename G, typename T>
+    void LandmarkOracle<G, T>::store(const std::vector<std::vector<size_t>> &forward,
+                                     const std::vector<std::vector<size_t>> &backward) {
+        size_t n = g.number_of_vertices(), k = landmarks.size();
+        size_t longest = 0;
+        for (const auto &table : {&forward, &backward}) {
+            for (const auto &row : *table) {
+                for (const auto &it : row) {
+                    if (it != INFINITE_DISTANCE) {
+                        longest = std::max(longest, it);
+                    }
+                }
+            }
+        }
+
+        size_t room = static_cast<size_t>(UNKNOWN) - 1;
+        scale = std::max<size_t>(1, longest / room + (longest % room != 0));
+
+        from_landmarks.resize(n * k);
+        to_landmarks.resize(n * k);
+        for (size_t i = 0; i < k; ++i) {
+            for (size_t v = 0; v < n; ++v) {
+                from_landmarks[v * k + i] = forward[i][v] == INFINITE_DISTANCE ? UNKNOWN
+                                                                              : static_cast<T>(forward[i][v] / scale);
+                to_landmarks[v * k + i] = backward[i][v] == INFINITE_DISTANCE ? UNKNOWN
+                                                                             : static_cast<T>(backward[i][v] / scale);
+            }
+        }
+    }
+
+    template<typename G, typename T>
+    size_t LandmarkOracle<G, T>::lower_bound(size_t vertex, size_t target) const {
+        /**
+        *  @brief Largest triangle-inequality bound on d(vertex, target) over all landmarks, 0 if none applies.
+        *  Stored values are rounded down, so a difference loses up to one unit of scale.
+        */
+        size_t k = landmarks.size(), slack = scale > 1;
+        const T *from_v = from_landmarks.data() + vertex * k, *from_t = from_landmarks.data() + target * k;
+        const T *to_v = to_landmarks.data() + vertex * k, *to_t = to_landmarks.data() + target * k;
+
+        size_t best = 0;
+        for (size_t i = 0; i < k; ++i) {
+            if (from_v[i] != UNKNOWN && from_t[i] != UNKNOWN && size_t(from_t[i]) > from_v[i] + slack) {
+                best = std::max(best, size_t(from_t[i]) - from_v[i] - slack);
+            }
+            if (to_v[i] != UNKNOWN && to_t[i] != UNKNOWN && size_t(to_v[i]) > to_t[i] + slack) {
+                best = std::max(best, size_t(to_v[i]) - to_t[i] - slack);
+            }
+        }
+        return best * scale;
+    }
+
+    template<typename G, typename T>
+    size_t LandmarkOracle<G, T>::upper_bound(size_t source, size_t target) const {
+        /**
+        *  @brief Length of the best route through a single landmark, INFINITE_DISTANCE if there is none.
+        */
+        check(source, target);
+        if (source == target) {
+            return 0;
+        }
+
+        size_t k = landmarks.size(), slack = scale > 1;
+        const T *to_s = to_landmarks.data() + source * k, *from_t = from_landmarks.data() + target * k;
+
+        size_t best = INFINITE_DISTANCE;
+        for (size_t i = 0; i < k; ++i) {
+            if (to_s[i] != UNKNOWN && from_t[i] != UNKNOWN) {
+                best = std::min(best, saturating_add(saturating_add<size_t>(to_s[i], from_t[i]), 2 * slack));
+            }
+        }
+        return best >= INFINITE_DISTANCE / scale ? INFINITE_DISTANCE : best * scale;
+    }
+
+    template<typename G, typename T>
+    Route LandmarkOracle<G, T>::route(size_t source, size_t target) {
+        /**
+        *  @brief Exact shortest route by A* with the landmark lower bounds as heuristic.
+        */
+        check(source, target);
+        return search.a_star(source, target, [this, target](size_t vertex) {
+            return lower_bound(vertex, target);
+        });
+    }
+}
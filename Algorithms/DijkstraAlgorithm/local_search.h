@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/binary_heap/binary_heap.h"
+#include "../../DataStructures/graph/graph.h"
+#include "dijkstra.h"
+
+
+namespace ShortestPaths {
+    struct Reached final {
+        size_t vertex;
+        size_t distance;
+        size_t parent;      // previous vertex on a shortest path, the source is its own parent
+    };
+
+    template<typename G>
+    class LocalSearch final {
+        /**
+        *  @brief Dijkstra that stops early and reports only what it settled, in order of distance. within()
+        *  stops once the heap minimum exceeds the radius, nearest() once k targets are settled. A vertex's
+        *  distance counts only if its stamp equals the current generation, so a query costs time in the size
+        *  of the explored ball and never clears per-vertex arrays; they are allocated once per engine.
+        */
+        const G &g;
+        std::vector<uint32_t> stamps;
+        std::vector<uint32_t> wanted;       // equals generation for targets of the current nearest() query
+        std::vector<size_t> distances;
+        std::vector<size_t> parents;
+        uint32_t generation;
+        BinaryHeap::IndexedBinaryHeap<size_t> heap;
+
+        void start(size_t source);
+
+        size_t reached(size_t vertex) const {
+            return stamps[vertex] == generation ? distances[vertex] : INFINITE_DISTANCE;
+        };
+
+        template<typename Stop>
+        std::vector<Reached> run(size_t radius, Stop &&stop);
+
+    public:
+        explicit LocalSearch(const G &new_g);
+
+        std::vector<Reached> within(size_t source, size_t radius);
+
+        std::vector<Reached> nearest(size_t source, const std::vector<size_t> &targets, size_t k,
+                                     size_t radius = INFINITE_DISTANCE);
+    };
+
+    template<typename G>
+    LocalSearch<G>::LocalSearch(const G &new_g) : g(new_g), stamps(new_g.number_of_vertices(), 0),
+                                                  wanted(new_g.number_of_vertices(), 0),
+                                                  distances(new_g.number_of_vertices()),
+                                                  parents(new_g.number_of_vertices()), generation(0),
+                                                  heap(new_g.number_of_vertices()) {
+        static_assert(graph::is_graph_v<G>, "LocalSearch expects a graph");
+    }
+
+    template<typename G>
+    void LocalSearch<G>::start(size_t source) {
+        if (source >= g.number_of_vertices()) {
+            throw std::invalid_argument("start position");
+        }
+
+        if (++generation == 0) {        // wrapped around, old stamps could look current again
+            std::fill(stamps.begin(), stamps.end(), 0);
+            std::fill(wanted.begin(), wanted.end(), 0);
+            generation = 1;
+        }
+        heap.clear();
+
+        stamps[source] = generation;
+        distances[source] = 0;
+        parents[source] = source;
+        heap.insert(0, source);
+    }
+
+    template<typename G>
+    template<typename Stop>
+    std::vector<Reached> LocalSearch<G>::run(size_t radius, Stop &&stop) {
+        /**
+        *  @brief Settles vertices up to radius; stop(vertex, result) may report a settled vertex by appending
+        *  it to result and returns true once the search should end.
+        */
+        std::vector<Reached> result;
+        while (!heap.empty() && heap.get_min().get_key() <= radius) {
+            auto node = heap.extract_min();
+            size_t vertex = node.get_value();
+            if (stop(vertex, result)) {
+                break;
+            }
+
+            for (const auto &it : g[vertex]) {
+                size_t target = graph::target_of(it);
+                size_t candidate = saturating_add(node.get_key(), graph::weight_of(it));
+                if (candidate <= radius && candidate < reached(target)) {
+                    stamps[target] = generation;
+                    distances[target] = candidate;
+                    parents[target] = vertex;
+                    heap.insert_or_decrease(candidate, target);
+                }
+            }
+        }
+        return result;
+    }
+
+    template<typename G>
+    std::vector<Reached> LocalSearch<G>::within(size_t source, size_t radius) {
+        /**
+        *  @brief Every vertex at distance at most radius from source, the isochrone of source.
+        */
+        start(source);
+        return run(radius, [this](size_t vertex, std::vector<Reached> &result) {
+            result.push_back({vertex, distances[vertex], parents[vertex]});
+            return false;
+        });
+    }
+
+    template<typename G>
+    std::vector<Reached> LocalSearch<G>::nearest(size_t source, const std::vector<size_t> &targets, size_t k,
+                                                 size_t radius) {
+        /**
+        *  @brief The k targets closest to source, fewer if the rest lie beyond radius or are unreachable.
+        *  Targets listed more than once are reported once.
+        */
+        start(source);
+        for (const auto &it : targets) {
+            if (it >= g.number_of_vertices()) {
+                throw std::invalid_argument("invalid vertices");
+            }
+            wanted[it] = generation;
+        }
+        if (k == 0) {
+            return {};
+        }
+
+        return run(radius, [this, k](size_t vertex, std::vector<Reached> &result) {
+            if (wanted[vertex] == generation) {
+                result.push_back({vertex, distances[vertex], parents[vertex]});
+            }
+            return result.size() == k;
+        });
+    }
+
+    template<typename G>
+    std::vector<Reached> isochrone(const G &g, size_t source, size_t radius) {
+        /**
+        *  @brief One-shot within(); keep a LocalSearch around to avoid the O(V) setup per query.
+        */
+        return LocalSearch<G>(g).within(source, radius);
+    }
+
+    template<typename G>
+    std::vector<Reached> nearest_targets(const G &g, size_t source, const std::vector<size_t> &targets, size_t k) {
+        /**
+        *  @brief One-shot nearest(); keep a LocalSearch around to avoid the O(V) setup per query.
+        */
+        return LocalSearch<G>(g).nearest(source, targets, k);
+    }
+}
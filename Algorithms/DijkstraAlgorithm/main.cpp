@@ -1,88 +1,31 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
-#include <queue>
+#include <stdexcept>
+#include <string>
 #include <vector>
-#include "../../DataStructures/binary_heap/binary_heap.h"
-#include "../../DataStructures/graph/graph.h"
-
-
-struct Size {
-    long int value;
-
-    Size() : value(-1) {};
-
-    Size(const Size& other) = default;
-
-    explicit Size(size_t new_value) : value(new_value) {};
-
-    Size& operator =(size_t new_value) {
-        value = new_value;
-        return *this;
-    };
-
-    explicit operator int() const {
-        return static_cast<int>(value);
-    };
-};
-
-Size operator +(const Size& lhs, const Size& rhs) {
-    Size result;
-
-    if (lhs.value == -1 || rhs.value == -1) {
-        result.value = -1;
-    } else {
-        result.value = lhs.value + rhs.value;
-    }
-    return result;
-}
-
-Size operator +(const Size& lhs, const size_t& rhs) {
-    Size result;
-    if (lhs.value != -1) {
-        result.value = static_cast<long int>(rhs) + lhs.value;
-    }
-    return result;
-}
 
-std::ostream& operator <<(std::ostream& os, const Size& obj) {
-    os << obj.value;
-    return os;
-}
-
-bool operator <(const Size& lhs, const Size& rhs) {
-    if (lhs.value != -1 && rhs.value != -1) {
-        return lhs.value < rhs.value;
-    } else if (rhs.value != -1) {
-        return false;
-    } else {
-        return lhs.value != -1;
-    }
-}
-
-bool operator ==(const Size& lhs, const Size& rhs) {
-    return lhs.value == rhs.value;
-}
-
-bool operator <=(const Size& lhs, const Size& rhs) {
-    return lhs < rhs || lhs == rhs;
-}
+#include <unistd.h>
 
-template <typename T>
-bool operator ==(const T& lhs, const Size& rhs) {
-    return lhs == rhs.value;
-}
-
-template <typename T>
-bool operator ==(const Size& lhs, const T& rhs) {
-    return lhs.value == rhs;
-}
-
-bool operator !=(const Size& lhs, const Size& rhs) {
-    return !(lhs == rhs);
-}
-
-bool operator >(const Size& lhs, const Size& rhs) {
-    return !(lhs < rhs) && (lhs != rhs);
-}
+#include "../../DataStructures/graph/csr_graph.h"
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/graph/graph_file.h"
+#include "../../DataStructures/graph/graph_reorder.h"
+#include "bfs.h"
+#include "contraction_hierarchy.h"
+#include "delta_stepping.h"
+#include "distance.h"
+#include "distance_table.h"
+#include "dynamic_sssp.h"
+#include "landmarks.h"
+#include "local_search.h"
+#include "multi_source_bfs.h"
+#include "point_to_point.h"
+#include "dijkstra.h"
+
+
+using Distance = ShortestPaths::Distance<size_t>;
 
 namespace {
     template <typename T>
@@ -93,84 +36,131 @@ namespace {
         return os;
     }
 
-    std::vector<Size> Dijkstra(const graph::DirectedGraph<graph::Node> &target_graph, const size_t &start) {
+    std::vector<Distance> as_distances(const std::vector<size_t> &values) {
+        std::vector<Distance> result;
+        result.reserve(values.size());
+        for (const auto &it : values) {
+            result.emplace_back(it);
+        }
+        return result;
+    }
+
+    template <typename G>
+    std::vector<Distance> Dijkstra(const G &target_graph, const size_t &start) {
+        static_assert(graph::is_graph_v<G>, "Dijkstra expects a graph");
+
         if (start >= target_graph.number_of_vertices()) {
             throw std::invalid_argument("start position");
         }
 
-        std::vector<Size> result(target_graph.number_of_vertices());
-        result[start] = 0;
+        return as_distances(ShortestPaths::dijkstra(target_graph, start).distances);
+    }
 
-        std::vector<bool> used(target_graph.number_of_vertices(), true);
-        BinaryHeap::BinaryHeap<Size, size_t> bheap;
+    template <typename G>
+    bool BFS(const G& target_graph, const size_t& start, const size_t& goal) {
+        static_assert(graph::is_graph_v<G>, "BFS expects a graph");
 
-        for (size_t i = 0, end_index = target_graph.number_of_vertices(); i < end_index; ++i) {
-            if (i != start) {
-                bheap.insert(Size(), i);
-            } else {
-                bheap.insert(Size(0), i);
-            }
+        if (start >= target_graph.number_of_vertices() || goal >= target_graph.number_of_vertices()) {
+            throw std::invalid_argument("nodes");
         }
 
-        while (!bheap.empty()) {
-            decltype(auto) node = bheap.extract_min();
-
-            used[node.get_value()] = false;
-            for (const auto &it : target_graph[node.get_value()]) {
-                if (used[it.number]) {
-                    if (result[node.get_value()] + it.weight < result[it.number]) {
-                        result[it.number] = result[node.get_value()] + it.weight;
-                    }
-                }
-            }
-
-            bheap.clear();
-            for (size_t i = 0, end_index = target_graph.number_of_vertices(); i < end_index; ++i) {
-                if (used[i]) {
-                    bheap.insert(Size(result[i]), i);
-                }
-            }
-        }
-
-        return result;
+        return ShortestPaths::bfs(target_graph, start).levels[goal] != ShortestPaths::UNREACHED;
     }
+}
 
-    bool BFS(const graph::DirectedGraph<graph::Node>& target_graph, const size_t& start, const size_t& goal) {
-         if (start >= target_graph.number_of_vertices() || goal >= target_graph.number_of_vertices()) {
-             throw std::invalid_argument("nodes");
-         }
-
-         std::vector<bool> visited(target_graph.number_of_vertices(), false);
-         visited[start] = true;
+int main() {
+    decltype(auto) example_graph = graph::generate_random_directed_graph<graph::Node>(10, 15, 20, 11);
+    std::cout << example_graph << std::endl << std::endl;
 
-         std::queue<size_t> unvisited_vertices;
-         unvisited_vertices.push(start);
+    std::cout << Dijkstra(example_graph, 0) << std::endl;
 
-         while (!unvisited_vertices.empty()) {
-             auto tmp = unvisited_vertices.front();
-             unvisited_vertices.pop();
+    const auto frozen_graph = graph::to_csr(example_graph);
+    std::cout << Dijkstra(frozen_graph, 0) << std::endl;
 
-             if (tmp == goal) {
-                 return true;
-             }
+    std::string graph_path = (std::filesystem::temp_directory_path() / "example_graph_XXXXXX").string();
+    int fd = ::mkstemp(graph_path.data());
+    if (fd < 0) {
+        std::cerr << "failed to create a temporary graph file" << std::endl;
+        return 1;
+    }
+    ::close(fd);
+    try {
+        graph::save_binary(graph_path, example_graph);
+        const auto mapped_graph = graph::load_binary(graph_path);
+        std::cout << Dijkstra(mapped_graph, 0) << std::endl;
+    } catch (std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        std::remove(graph_path.c_str());
+        return 1;
+    }
+    std::remove(graph_path.c_str());
 
-             for (auto it : target_graph[tmp]) {
-                 if (!visited[it.number]) {
-                     unvisited_vertices.push(it.number);
-                     visited[it.number] = true;
-                 }
-             }
-         }
+    auto local_graph = example_graph;
+    const auto permutation = graph::reorder::relabel(local_graph, graph::reorder::Order::REVERSE_CUTHILL_MCKEE);
+    std::cout << graph::reorder::restore(Dijkstra(local_graph, permutation.new_ids[0]), permutation.old_ids)
+              << std::endl;
 
-         return false;
+    const auto tree = ShortestPaths::bfs(example_graph, 0);
+    for (size_t i = 0; i < tree.levels.size(); ++i) {
+        if (tree.levels[i] != ShortestPaths::UNREACHED) {
+            std::cout << i << ": " << tree.levels[i] << " hops via " << tree.parents[i] << std::endl;
+        }
     }
-}
+    std::cout << std::boolalpha << BFS(example_graph, 0, 9) << std::endl;
+    ShortestPaths::MultiSourceBFS<decltype(example_graph)> sweep(example_graph);
+    for (const auto &it : sweep.statistics({0, 1, 2, 3})) {
+        std::cout << it.reached << " reached, eccentricity " << it.eccentricity << std::endl;
+    }
+    std::cout << ShortestPaths::path(ShortestPaths::dijkstra(example_graph, 0).parents, 4) << std::endl;
+    std::cout << ShortestPaths::path(ShortestPaths::delta_stepping(example_graph, 0, 5).parents, 4) << std::endl;
+    std::cout << ShortestPaths::shortest_route(example_graph, 0, 4).path << std::endl;
+
+    std::string hierarchy_path = (std::filesystem::temp_directory_path() / "example_graph_ch_XXXXXX").string();
+    fd = ::mkstemp(hierarchy_path.data());
+    if (fd < 0) {
+        std::cerr << "failed to create a temporary contraction hierarchy file" << std::endl;
+        return 1;
+    }
+    ::close(fd);
+    ShortestPaths::ContractionHierarchy hierarchy;
+    try {
+        ShortestPaths::contract(example_graph).save(hierarchy_path);
+        hierarchy = ShortestPaths::ContractionHierarchy::load(hierarchy_path);
+        std::cout << hierarchy.route(0, 4).path << "cost " << hierarchy.distance(0, 4) << std::endl;
+    } catch (std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        std::remove(hierarchy_path.c_str());
+        return 1;
+    }
+    std::remove(hierarchy_path.c_str());
 
-int main() {
-    decltype(auto) example_graph = graph::generate_random_directed_graph<graph::Node>(10, 15, 20);
-    std::cout << example_graph << std::endl << std::endl;
+    ShortestPaths::LandmarkOracle<decltype(example_graph), uint16_t> oracle(example_graph, 3);
+    std::cout << oracle.route(0, 4).path << "between " << oracle.lower_bound(0, 4) << " and "
+              << oracle.approximate(0, 4) << std::endl;
 
-    std::cout << Dijkstra(example_graph, 0) << std::endl;
+    const std::vector<size_t> sources{0, 3, 7}, targets{1, 4, 9};
+    std::cout << as_distances(ShortestPaths::distance_table(example_graph, sources, targets).distances) << std::endl;
+    std::cout << as_distances(hierarchy.table(sources, targets).distances) << std::endl;
+
+    ShortestPaths::LocalSearch<decltype(example_graph)> local(example_graph);
+    for (const auto &it : local.within(0, 20)) {
+        std::cout << it.vertex << " at " << it.distance << std::endl;
+    }
+    for (const auto &it : local.nearest(0, targets, 2)) {
+        std::cout << "target " << it.vertex << " at " << it.distance << std::endl;
+    }
+
+    auto changing_graph = example_graph;
+    ShortestPaths::DynamicShortestPaths<decltype(changing_graph)> dynamic(changing_graph, 0);
+    dynamic.apply({{{0, graph::Node(4, 1)}}, {{0, changing_graph[0].front()}}});
+    std::cout << ShortestPaths::path(dynamic.get_parents(), 4) << "after " << dynamic.last_settled() << " settled"
+              << std::endl;
+
+    graph::DirectedGraph<graph::Node> overflow_graph(3, true);      // 0 -> 1 -> 2 is longer than any distance
+    overflow_graph.add_edge(0, graph::Node(1, ShortestPaths::INFINITE_DISTANCE - 2));
+    overflow_graph.add_edge(1, graph::Node(2, 5));
+    std::cout << Dijkstra(overflow_graph, 0) << "| "
+              << as_distances(ShortestPaths::contract(overflow_graph).table({0}, {2}).distances) << std::endl;
 
     return 0;
 }
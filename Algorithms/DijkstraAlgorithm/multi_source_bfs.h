@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+#include "bfs.h"
+#include "distance_table.h"
+
+
+namespace ShortestPaths {
+    struct HopStatistics final {
+        size_t reached;         // vertices reachable from the source, the source included
+        size_t total;           // sum of their hop distances, closeness is (reached - 1) / total
+        size_t eccentricity;    // largest hop distance to a reachable vertex
+    };
+
+    template<typename G, size_t Words = 1>
+    class MultiSourceBFS final {
+        /**
+        *  @brief Bit-parallel multi-source BFS (Then et al.): up to 64 * Words traversals share one sweep, every
+        *  vertex keeping one bit per traversal in its seen, frontier and next masks. A dense level lets every
+        *  vertex pull the frontier masks of its in-neighbours, so each edge is read once per level for all
+        *  traversals together and vertices split over threads without synchronization. A sparse level, whose
+        *  frontier has fewer than 1 / ALPHA of the edges, pushes the frontier masks along the out-edges of the
+        *  frontier instead, with atomic ORs, so it costs only those edges. Words = 4 gives 256 lanes whose mask
+        *  operations the compiler turns into AVX2 instructions.
+        */
+        static_assert(Words > 0, "at least one 64-bit word of lanes");
+
+        static constexpr size_t LANES = 64 * Words;
+        static constexpr size_t ALPHA = 14;         // push while frontier edges < (edges + vertices) / ALPHA
+        static constexpr size_t GRAIN = 2048;       // smaller levels stay on the calling thread
+
+        using Mask = std::array<uint64_t, Words>;
+
+        struct alignas(64) Worker final {
+            std::vector<size_t> found;
+            bool active = false;
+        };
+
+        const G &g;
+        size_t threads;
+        bool directed;
+        std::vector<size_t> in_offsets;
+        std::vector<size_t> in_sources;
+        size_t entries;     // adjacency entries, the edges a pull level reads
+
+        std::vector<Mask> seen;
+        std::vector<Mask> frontier;
+        std::vector<Mask> next;
+        std::vector<std::atomic<size_t>> stamps;        // last push step that found the vertex
+        size_t step;
+        std::vector<size_t> current;        // vertices of the frontier
+        std::vector<size_t> previous;       // and of the one before, whose next masks a push step clears
+        std::vector<Worker> workers;
+
+        size_t workers_for(size_t work) const {
+            return std::max<size_t>(1, std::min(threads, work / GRAIN));
+        };
+
+        static bool any(const Mask &mask) {
+            uint64_t result = 0;
+            for (size_t i = 0; i < Words; ++i) {
+                result |= mask[i];
+            }
+            return result != 0;
+        };
+
+        void pull(size_t vertex, const Mask &full, Worker &worker);
+
+        void push(size_t vertex, Worker &worker);
+
+        template<typename F>
+        void batch(const size_t *sources, size_t count, size_t offset, F &&f);
+
+    public:
+        explicit MultiSourceBFS(const G &new_g, size_t new_threads = ThreadPool::default_threads());
+
+        template<typename F>
+        void for_each(const std::vector<size_t> &sources, F &&f);
+
+        DistanceTable levels(const std::vector<size_t> &sources);
+
+        std::vector<HopStatistics> statistics(const std::vector<size_t> &sources);
+    };
+
+    template<typename G, size_t Words>
+    MultiSourceBFS<G, Words>::MultiSourceBFS(const G &new_g, size_t new_threads) :
+            g(new_g), threads(std::max<size_t>(1, new_threads)), directed(graph::is_directed(new_g)),
+            seen(new_g.number_of_vertices()), frontier(new_g.number_of_vertices()),
+            next(new_g.number_of_vertices()), stamps(new_g.number_of_vertices()), step(0), workers(threads) {
+        static_assert(graph::is_graph_v<G>, "MultiSourceBFS expects a graph");
+        size_t n = g.number_of_vertices();
+        entries = 0;
+        for (size_t i = 0; i < n; ++i) {
+            entries += g[i].size();
+            stamps[i].store(0, std::memory_order_relaxed);
+        }
+        if (!directed) {
+            return;
+        }
+
+        in_offsets.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &it : g[i]) {
+                ++in_offsets[graph::target_of(it) + 1];
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            in_offsets[i + 1] += in_offsets[i];
+        }
+
+        std::vector<size_t> fill(in_offsets.begin(), in_offsets.end() - 1);
+        in_sources.resize(in_offsets[n]);
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &it : g[i]) {
+                in_sources[fill[graph::target_of(it)]++] = i;
+            }
+        }
+    }
+
+    template<typename G, size_t Words>
+    void MultiSourceBFS<G, Words>::pull(size_t vertex, const Mask &full, Worker &worker) {
+        auto &mask = next[vertex];
+        bool done = true;
+        for (size_t i = 0; i < Words; ++i) {
+            mask[i] = 0;
+            done = done && seen[vertex][i] == full[i];
+        }
+        if (done) {     // every traversal of the batch has been here
+            return;
+        }
+
+        auto gather = [&mask, this](size_t source) {
+            for (size_t i = 0; i < Words; ++i) {
+                mask[i] |= frontier[source][i];
+            }
+        };
+        if (directed) {
+            for (size_t i = in_offsets[vertex], end_ = in_offsets[vertex + 1]; i < end_; ++i) {
+                gather(in_sources[i]);
+            }
+        } else {
+            for (const auto &it : g[vertex]) {
+                gather(graph::target_of(it));
+            }
+        }
+
+        for (size_t i = 0; i < Words; ++i) {
+            mask[i] &= ~seen[vertex][i];
+            seen[vertex][i] |= mask[i];
+        }
+        if (any(mask)) {
+            worker.found.push_back(vertex);
+            worker.active = true;
+        }
+    }
+
+    template<typename G, size_t Words>
+    void MultiSourceBFS<G, Words>::push(size_t vertex, Worker &worker) {
+        for (const auto &it : g[vertex]) {
+            size_t target = graph::target_of(it);
+            bool found = false;
+            for (size_t i = 0; i < Words; ++i) {
+                uint64_t bits = frontier[vertex][i] & ~seen[target][i];
+                if (bits) {     // plain loads first: most of these bits and stamps are already set
+                    found = true;
+                    if (bits & ~__atomic_load_n(&next[target][i], __ATOMIC_RELAXED)) {
+                        __atomic_fetch_or(&next[target][i], bits, __ATOMIC_RELAXED);
+                    }
+                }
+            }
+            if (found && stamps[target].load(std::memory_order_relaxed) != step &&
+                stamps[target].exchange(step, std::memory_order_relaxed) != step) {
+                worker.found.push_back(target);
+                worker.active = true;
+            }
+        }
+    }
+
+    template<typename G, size_t Words>
+    template<typename F>
+    void MultiSourceBFS<G, Words>::batch(const size_t *sources, size_t count, size_t offset, F &&f) {
+        size_t n = g.number_of_vertices();
+        std::fill(seen.begin(), seen.end(), Mask{});
+        std::fill(frontier.begin(), frontier.end(), Mask{});
+        std::fill(next.begin(), next.end(), Mask{});
+
+        Mask full{};
+        size_t frontier_edges = 0;
+        current.clear();
+        previous.clear();
+        for (size_t lane = 0; lane < count; ++lane) {
+            full[lane / 64] |= uint64_t(1) << (lane % 64);
+            seen[sources[lane]][lane / 64] |= uint64_t(1) << (lane % 64);
+            frontier[sources[lane]][lane / 64] |= uint64_t(1) << (lane % 64);
+            f(offset + lane, sources[lane], static_cast<size_t>(0));
+            current.push_back(sources[lane]);       // a repeated source is pushed twice, which changes nothing
+            frontier_edges += g[sources[lane]].size();
+        }
+
+        for (size_t level = 1;; ++level) {
+            bool top_down = frontier_edges * ALPHA < entries + n;
+            if (top_down) {
+                for (const auto &vertex : previous) {
+                    next[vertex] = Mask{};
+                }
+                ++step;
+                ThreadPool::parallel_for(current.size(), [this](size_t i, size_t worker) {
+                    push(current[i], workers[worker]);
+                }, workers_for(current.size()));
+            } else {
+                ThreadPool::parallel_for(n, [this, &full](size_t vertex, size_t worker) {
+                    pull(vertex, full, workers[worker]);
+                }, workers_for(n));
+            }
+
+            bool active = false;
+            frontier_edges = 0;
+            previous.swap(current);
+            current.clear();
+            for (auto &worker : workers) {
+                active = active || worker.active;
+                worker.active = false;
+                for (const auto &vertex : worker.found) {
+                    if (top_down) {
+                        for (size_t i = 0; i < Words; ++i) {
+                            seen[vertex][i] |= next[vertex][i];
+                        }
+                    }
+                    current.push_back(vertex);
+                    frontier_edges += g[vertex].size();
+                    for (size_t i = 0; i < Words; ++i) {
+                        for (uint64_t bits = next[vertex][i]; bits; bits &= bits - 1) {
+                            f(offset + 64 * i + static_cast<size_t>(__builtin_ctzll(bits)), vertex, level);
+                        }
+                    }
+                }
+                worker.found.clear();
+            }
+            if (!active) {
+                break;
+            }
+            frontier.swap(next);
+        }
+    }
+
+    template<typename G, size_t Words>
+    template<typename F>
+    void MultiSourceBFS<G, Words>::for_each(const std::vector<size_t> &sources, F &&f) {
+        /**
+        *  @brief Calls f(i, vertex, hops) once for every vertex reachable from sources[i], on the calling thread
+        *  and in non-decreasing hops per source. Sources are processed in batches of 64 * Words.
+        */
+        detail::check_vertices(sources, g.number_of_vertices());
+        for (size_t offset = 0; offset < sources.size(); offset += LANES) {
+            batch(sources.data() + offset, std::min(LANES, sources.size() - offset), offset, f);
+        }
+    }
+
+    template<typename G, size_t Words>
+    DistanceTable MultiSourceBFS<G, Words>::levels(const std::vector<size_t> &sources) {
+        /**
+        *  @brief Hop distances, one row per source and one column per vertex, UNREACHED if there is no path.
+        */
+        DistanceTable result(sources.size(), g.number_of_vertices());
+        for_each(sources, [&result](size_t row, size_t vertex, size_t hops) {
+            result(row, vertex) = hops;
+        });
+        return result;
+    }
+
+    template<typename G, size_t Words>
+    std::vector<HopStatistics> MultiSourceBFS<G, Words>::statistics(const std::vector<size_t> &sources) {
+        /**
+        *  @brief Reach, total hops and eccentricity of every source without storing any distances.
+        */
+        std::vector<HopStatistics> result(sources.size(), HopStatistics{0, 0, 0});
+        for_each(sources, [&result](size_t row, size_t, size_t hops) {
+            auto &it = result[row];
+            ++it.reached;
+            it.total += hops;
+            it.eccentricity = std::max(it.eccentricity, hops);
+        });
+        return result;
+    }
+
+    template<typename G>
+    DistanceTable hop_distances(const G &g, const std::vector<size_t> &sources,
+                                size_t threads = ThreadPool::default_threads()) {
+        /**
+        *  @brief One-shot all-sources hop table over 64-lane batches.
+        */
+        return MultiSourceBFS<G>(g, threads).levels(sources);
+    }
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../../DataStructures/binary_heap/binary_heap.h"
+#include "../../DataStructures/graph/csr_graph.h"
+#include "../../DataStructures/graph/graph.h"
+#include "dijkstra.h"
+
+
+namespace ShortestPaths {
+    struct Route final {
+        size_t distance;                // INFINITE_DISTANCE if target is unreachable
+        std::vector<size_t> path;       // source ... target, empty if unreachable
+    };
+
+    struct ZeroHeuristic final {
+        size_t operator()(size_t) const {
+            return 0;
+        };
+    };
+
+    template<typename G>
+    class PointToPoint final {
+        /**
+        *  @brief s-t queries that stop as soon as the answer is known. bidirectional() grows Dijkstra balls from
+        *  both ends (the backward one over the reversed graph, kept here for directed graphs) and stops once the
+        *  two heap minima add up to the best meeting distance. a_star() runs a single search ordered by
+        *  distance + heuristic(v), where heuristic must never overestimate the distance from v to the target.
+        *  Scratch arrays are reused across queries and reset only where the previous query touched them.
+        */
+        using node_type = typename G::node_type;
+
+        struct Side final {
+            std::vector<size_t> distances;
+            std::vector<size_t> parents;
+            std::vector<size_t> touched;
+            BinaryHeap::IndexedBinaryHeap<size_t> heap;
+
+            explicit Side(size_t n) : distances(n, INFINITE_DISTANCE), parents(n, INFINITE_DISTANCE), heap(n) {};
+
+            void reset() {
+                for (const auto &it : touched) {
+                    distances[it] = INFINITE_DISTANCE;
+                    parents[it] = INFINITE_DISTANCE;
+                }
+                touched.clear();
+                heap.clear();
+            };
+
+            void reach(size_t vertex, size_t distance, size_t parent, size_t key) {
+                if (distances[vertex] == INFINITE_DISTANCE) {
+                    touched.push_back(vertex);
+                }
+                distances[vertex] = distance;
+                parents[vertex] = parent;
+                heap.insert_or_decrease(key, vertex);
+            };
+        };
+
+        const G &g;
+        bool directed;
+        graph::CSRGraph<node_type> reverse;     // empty for undirected graphs, they are their own reverse
+        Side forward;
+        Side backward;
+
+        template<typename H>
+        void step(const H &h, Side &side, const Side &other, size_t &best, size_t &meeting);
+
+        void check(size_t source, size_t target) const {
+            if (source >= g.number_of_vertices() || target >= g.number_of_vertices()) {
+                throw std::invalid_argument("nodes");
+            }
+        };
+
+        Route route(size_t distance, size_t meeting, size_t target) const;
+
+    public:
+        explicit PointToPoint(const G &new_g);
+
+        Route bidirectional(size_t source, size_t target);
+
+        template<typename Heuristic = ZeroHeuristic>
+        Route a_star(size_t source, size_t target, Heuristic &&heuristic = Heuristic());
+    };
+
+    template<typename G>
+    PointToPoint<G>::PointToPoint(const G &new_g) : g(new_g), directed(graph::is_directed(new_g)),
+                                                    forward(new_g.number_of_vertices()),
+                                                    backward(new_g.number_of_vertices()) {
+        static_assert(graph::is_graph_v<G>, "PointToPoint expects a graph");
+        if (directed) {
+            reverse = graph::transpose(g);
+        }
+    }
+
+    template<typename G>
+    template<typename H>
+    void PointToPoint<G>::step(const H &h, Side &side, const Side &other, size_t &best, size_t &meeting) {
+        size_t vertex = side.heap.extract_min().get_value();
+        size_t distance = side.distances[vertex];
+
+        for (const auto &it : h[vertex]) {
+            size_t next = graph::target_of(it);
+            size_t candidate = saturating_add(distance, graph::weight_of(it));
+            if (candidate < side.distances[next]) {
+                side.reach(next, candidate, vertex, candidate);
+            }
+            size_t through = saturating_add(side.distances[next], other.distances[next]);
+            if (through < best) {
+                best = through;
+                meeting = next;
+            }
+        }
+    }
+
+    template<typename G>
+    Route PointToPoint<G>::route(size_t distance, size_t meeting, size_t target) const {
+        Route result{distance, {}};
+        if (distance == INFINITE_DISTANCE) {
+            return result;
+        }
+
+        for (size_t vertex = meeting; ; vertex = forward.parents[vertex]) {
+            result.path.push_back(vertex);
+            if (forward.parents[vertex] == vertex) {
+                break;
+            }
+        }
+        std::reverse(result.path.begin(), result.path.end());
+
+        for (size_t vertex = meeting; vertex != target; ) {
+            vertex = backward.parents[vertex];
+            result.path.push_back(vertex);
+        }
+        return result;
+    }
+
+    template<typename G>
+    Route PointToPoint<G>::bidirectional(size_t source, size_t target) {
+        check(source, target);
+        forward.reset();
+        backward.reset();
+
+        forward.reach(source, 0, source, 0);
+        backward.reach(target, 0, target, 0);
+
+        size_t best = source == target ? 0 : INFINITE_DISTANCE;
+        size_t meeting = source;
+        while (!forward.heap.empty() && !backward.heap.empty()) {
+            if (saturating_add(forward.heap.get_min().get_key(), backward.heap.get_min().get_key()) >= best) {
+                break;
+            }
+
+            if (forward.heap.size() <= backward.heap.size()) {      // grow the cheaper frontier
+                step(g, forward, backward, best, meeting);
+            } else if (directed) {
+                step(reverse, backward, forward, best, meeting);
+            } else {
+                step(g, backward, forward, best, meeting);
+            }
+        }
+
+        return route(best, meeting, target);
+    }
+
+    template<typename G>
+    template<typename Heuristic>
+    Route PointToPoint<G>::a_star(size_t source, size_t target, Heuristic &&heuristic) {
+        check(source, target);
+        forward.reset();
+        backward.reset();
+
+        forward.reach(source, 0, source, heuristic(source));
+        while (!forward.heap.empty()) {
+            size_t vertex = forward.heap.extract_min().get_value();
+            if (vertex == target) {
+                break;
+            }
+
+            size_t distance = forward.distances[vertex];
+            for (const auto &it : g[vertex]) {
+                size_t next = graph::target_of(it);
+                size_t candidate = saturating_add(distance, graph::weight_of(it));
+                if (candidate < forward.distances[next]) {
+                    forward.reach(next, candidate, vertex, saturating_add(candidate, heuristic(next)));
+                }
+            }
+        }
+
+        return route(forward.distances[target], target, target);
+    }
+
+    template<typename G>
+    Route shortest_route(const G &g, size_t source, size_t target) {
+        /**
+        *  @brief One-shot bidirectional query; keep a PointToPoint around to answer many.
+        */
+        return PointToPoint<G>(g).bidirectional(source, target);
+    }
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "feasibility.h"
+
+
+namespace Euler {
+    namespace detail {
+        template<typename G>
+        size_t pair_slots(const G &g, const std::vector<size_t> &offsets, std::vector<size_t> &edge_ids,
+                          std::vector<size_t> *ends = nullptr) {
+            /**
+            *  @brief Gives both copies of every undirected edge the same id in O(V + E), slots numbered from
+            *  offsets[v] in row v. Copies u -> v with u < v get fresh ids and are queued at v in order of u; when
+            *  v's turn comes, a copy v -> u takes the next queued id of the run of u. The two copies of a
+            *  self-loop are consecutive in their row. ends, if given, receives the two slots of edge i at
+            *  2 * i and 2 * i + 1, the smaller first. Returns the number of edges.
+            */
+            size_t n = g.number_of_vertices();
+            std::vector<size_t> queue_offsets(n + 1, 0);
+            for (size_t u = 0; u < n; ++u) {
+                for (const auto &it : g[u]) {
+                    if (graph::target_of(it) > u) {
+                        ++queue_offsets[graph::target_of(it) + 1];
+                    }
+                }
+            }
+            for (size_t v = 0; v < n; ++v) {
+                queue_offsets[v + 1] += queue_offsets[v];
+            }
+
+            std::vector<std::pair<size_t, size_t>> queued(queue_offsets[n]);        // (u, id) queued at v
+            std::vector<size_t> fill(queue_offsets.begin(), queue_offsets.end() - 1);
+            std::vector<size_t> runs(n);
+            edge_ids.resize(offsets[n]);
+            if (ends) {
+                ends->resize(offsets[n]);
+            }
+
+            size_t next = 0;
+            for (size_t v = 0; v < n; ++v) {
+                for (size_t i = queue_offsets[v + 1]; i-- > queue_offsets[v];) {
+                    runs[queued[i].first] = i;      // ends at the first entry of each run
+                }
+
+                size_t loop = NO_PATH;
+                const auto &row = g[v];
+                for (size_t i = 0, end_ = row.size(); i < end_; ++i) {
+                    size_t u = graph::target_of(row[i]), slot = offsets[v] + i, &id = edge_ids[slot];
+                    bool second = true;
+                    if (u > v) {
+                        id = next++;
+                        queued[fill[u]++] = {v, id};
+                        second = false;
+                    } else if (u < v) {
+                        id = queued[runs[u]++].second;
+                    } else if (loop == NO_PATH) {
+                        id = loop = next++;
+                        second = false;
+                    } else {
+                        id = loop;
+                        loop = NO_PATH;
+                    }
+                    if (ends) {
+                        (*ends)[2 * id + second] = slot;
+                    }
+                }
+            }
+            return next;
+        }
+    }
+
+    template<typename G>
+    class Hierholzer final {
+        /**
+        *  @brief Euler path or circuit in O(V + E) over a read-only graph (Hierholzer). Every vertex keeps a
+        *  cursor to the next unused slot of its row, so no edge is ever erased or looked at twice. In an
+        *  undirected graph each edge sits in two rows; both copies share an edge id, computed once by the
+        *  constructor, and a used-edge bitset lets the second copy be skipped. The walk comes out back to front
+        *  with known positions, so it goes straight into an output of exactly E + 1 vertices or to a sink.
+        *  The graph must not change while the engine is alive.
+        */
+        struct Cursor final {       // one cache line holds everything a step needs about its vertex
+            size_t first;           // slots of the vertex are first .. last - 1, numbered across all rows
+            size_t next;
+            size_t last;
+        };
+
+        const G &g;
+        bool directed;
+        size_t start;
+        std::vector<Cursor> cursors;
+        std::vector<size_t> edge_ids;       // undirected only: slot -> edge id shared by the two copies
+        std::vector<uint64_t> used;         // undirected only: bitset over edge ids
+        std::vector<size_t> stack;
+
+        bool take(size_t slot) {
+            if (directed) {
+                return true;
+            }
+            size_t id = edge_ids[slot];
+            uint64_t bit = uint64_t(1) << (id % 64);
+            if (used[id / 64] & bit) {
+                return false;
+            }
+            used[id / 64] |= bit;
+            return true;
+        };
+
+    public:
+        explicit Hierholzer(const G &new_g);
+
+        [[nodiscard]] size_t get_start() const {
+            return start;
+        };
+
+        [[nodiscard]] size_t length() const {       // vertices in an Euler path, E + 1
+            size_t slots = cursors.empty() ? 0 : cursors.back().last;
+            return (directed ? slots : slots / 2) + 1;
+        };
+
+        template<typename Sink>
+        bool stream(Sink &&sink);
+
+        bool path(std::vector<size_t> &result);
+
+        std::vector<size_t> path();
+    };
+
+    template<typename G>
+    Hierholzer<G>::Hierholzer(const G &new_g) : g(new_g), directed(graph::is_directed(new_g)), start(NO_PATH) {
+        static_assert(graph::is_graph_v<G>, "Hierholzer expects a graph");
+
+        size_t n = g.number_of_vertices(), slots = 0;
+        cursors.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            cursors[i] = {slots, slots, slots + g[i].size()};
+            slots = cursors[i].last;
+        }
+
+        if (!directed) {
+            std::vector<size_t> offsets(n + 1, slots);
+            for (size_t i = 0; i < n; ++i) {
+                offsets[i] = cursors[i].first;
+            }
+            used.assign((detail::pair_slots(g, offsets, edge_ids) + 63) / 64, 0);
+        }
+
+        const auto in = directed ? detail::in_degrees(g, 1) : std::vector<size_t>();
+        start = detail::balance(g, in, 1).start;        // connectivity shows up as a short walk
+    }
+
+    template<typename G>
+    template<typename Sink>
+    bool Hierholzer<G>::stream(Sink &&sink) {
+        /**
+        *  @brief Emits an Euler path, or circuit if every vertex is balanced, as sink(position, vertex) calls
+        *  with position running from length() - 1 down to 0. A vertex is emitted when the walk backtracks over
+        *  it, which is when its place in the path becomes final, so nothing but the walk's stack is buffered.
+        *  Returns false if the graph has no Euler path; if that is only found out on the way, because some
+        *  edges are not connected to the start, part of the path has already been emitted.
+        */
+        if (start == NO_PATH) {
+            return false;
+        }
+
+        for (auto &it : cursors) {
+            it.next = it.first;
+        }
+        std::fill(used.begin(), used.end(), 0);
+        stack.clear();
+
+        size_t position = length();
+        stack.push_back(start);
+        while (!stack.empty()) {
+            size_t vertex = stack.back();
+            auto &cursor = cursors[vertex];
+            while (cursor.next < cursor.last && !take(cursor.next)) {
+                ++cursor.next;
+            }
+
+            if (cursor.next < cursor.last) {
+                stack.push_back(graph::target_of(g[vertex][cursor.next - cursor.first]));
+                ++cursor.next;
+            } else {
+                stack.pop_back();
+                sink(--position, vertex);
+            }
+        }
+        return position == 0;       // otherwise some edges are not reachable from the start
+    }
+
+    template<typename G>
+    bool Hierholzer<G>::path(std::vector<size_t> &result) {
+        /**
+        *  @brief Writes the path of stream() into result as E + 1 vertices; result is left empty if there is
+        *  none, that is if the degrees do not allow one or the edges are not all connected to the start.
+        */
+        result.clear();
+        if (start == NO_PATH) {
+            return false;
+        }
+
+        result.resize(length());
+        if (!stream([&result](size_t position, size_t vertex) {
+            result[position] = vertex;
+        })) {
+            result.clear();
+            return false;
+        }
+        return true;
+    }
+
+    template<typename G>
+    std::vector<size_t> Hierholzer<G>::path() {
+        std::vector<size_t> result;
+        path(result);
+        return result;
+    }
+
+    template<typename G>
+    std::vector<size_t> euler_path(const G &g) {
+        /**
+        *  @brief One-shot Euler path, empty if the graph has none.
+        */
+        return Hierholzer<G>(g).path();
+    }
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+
+
+namespace Euler {
+    constexpr size_t NO_PATH = std::numeric_limits<size_t>::max();
+
+    struct Imbalance final {
+        size_t vertex;
+        std::ptrdiff_t surplus;     // out-degree minus in-degree; the (odd) degree in an undirected graph
+    };
+
+    struct Feasibility final {
+        std::vector<Imbalance> unbalanced;      // in order of vertices
+        size_t components;                      // (weakly) connected components that have edges
+        size_t start;                           // where an Euler path starts, NO_PATH if there is none
+
+        [[nodiscard]] bool has_path() const {
+            return start != NO_PATH;
+        };
+
+        [[nodiscard]] bool has_circuit() const {
+            return start != NO_PATH && unbalanced.empty();
+        };
+    };
+
+    namespace detail {
+        constexpr size_t GRAIN = 4096;          // fewer vertices per worker stay on the calling thread
+
+        inline size_t workers_for(size_t work, size_t threads) {
+            return std::max<size_t>(1, std::min(threads, work / GRAIN));
+        }
+
+        template<typename G, typename = void>
+        struct has_in_degree : std::false_type {
+        };
+
+        template<typename G>
+        struct has_in_degree<G, std::void_t<decltype(std::declval<const G &>().in_degree(size_t(0)))>>
+                : std::true_type {
+        };
+
+        template<typename G>
+        std::vector<size_t> in_degrees(const G &g, size_t threads) {
+            /**
+            *  @brief In-degrees of a directed graph: read from the graph when it maintains them, counted otherwise.
+            */
+            size_t n = g.number_of_vertices();
+            std::vector<size_t> result(n, 0);
+            if constexpr (has_in_degree<G>::value) {
+                ThreadPool::parallel_for(n, [&g, &result](size_t i, size_t) {
+                    result[i] = g.in_degree(i);
+                }, workers_for(n, threads));
+            } else {
+                for (size_t i = 0; i < n; ++i) {
+                    for (const auto &it : g[i]) {
+                        ++result[graph::target_of(it)];
+                    }
+                }
+            }
+            return result;
+        }
+
+        template<typename G>
+        Feasibility balance(const G &g, const std::vector<size_t> &in, size_t threads) {
+            /**
+            *  @brief Degree half of the check in one pass: collects the unbalanced vertices and picks the start,
+            *  the vertex with one more exit than entry or the first odd vertex, else the first vertex with edges.
+            *  Leaves components at 0, the caller decides about connectivity.
+            */
+            struct alignas(64) Worker final {
+                std::vector<Imbalance> found;
+                size_t first = NO_PATH;
+                bool broken = false;        // some surplus is beyond +-1
+            };
+
+            size_t n = g.number_of_vertices(), count = workers_for(n, threads);
+            bool directed = graph::is_directed(g);
+            std::vector<Worker> workers(count);
+            ThreadPool::parallel_for(n, [&](size_t vertex, size_t worker) {
+                auto &state = workers[worker];
+                auto out = static_cast<std::ptrdiff_t>(g[vertex].size());
+                if (out > 0 && state.first == NO_PATH) {
+                    state.first = vertex;
+                }
+
+                std::ptrdiff_t surplus = directed ? out - static_cast<std::ptrdiff_t>(in[vertex]) : out % 2;
+                if (surplus != 0) {
+                    state.found.push_back({vertex, directed ? surplus : out});
+                    state.broken = state.broken || surplus > 1 || surplus < -1;
+                }
+            }, count);
+
+            Feasibility result{{}, 0, NO_PATH};
+            size_t first = NO_PATH;
+            bool broken = false;
+            for (auto &it : workers) {      // blocks are contiguous and in order, so vertices stay sorted
+                result.unbalanced.insert(result.unbalanced.end(), it.found.begin(), it.found.end());
+                first = std::min(first, it.first);
+                broken = broken || it.broken;
+            }
+
+            const auto &unbalanced = result.unbalanced;
+            if (n == 0 || broken || (unbalanced.size() != 0 && unbalanced.size() != 2)) {
+                return result;
+            }
+            if (unbalanced.empty()) {
+                result.start = first == NO_PATH ? 0 : first;
+            } else if (!directed) {
+                result.start = unbalanced[0].vertex;
+            } else if (unbalanced[0].surplus != unbalanced[1].surplus) {
+                result.start = unbalanced[0].surplus > 0 ? unbalanced[0].vertex : unbalanced[1].vertex;
+            }
+            return result;
+        }
+
+        inline size_t find(std::vector<std::atomic<size_t>> &parents, size_t vertex) {
+            /**
+            *  @brief Root of vertex with path halving; parents only ever point to smaller ids, so a failed
+            *  halving still leaves vertex on a path to its root.
+            */
+            while (true) {
+                size_t parent = parents[vertex].load(std::memory_order_acquire);
+                if (parent == vertex) {
+                    return vertex;
+                }
+                size_t grandparent = parents[parent].load(std::memory_order_acquire);
+                if (parent != grandparent) {
+                    parents[vertex].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel);
+                }
+                vertex = grandparent;
+            }
+        }
+
+        inline void unite(std::vector<std::atomic<size_t>> &parents, size_t first, size_t second) {
+            while (true) {
+                first = find(parents, first);
+                second = find(parents, second);
+                if (first == second) {
+                    return;
+                }
+                if (first < second) {
+                    std::swap(first, second);
+                }
+
+                size_t expected = first;        // still a root, unless another thread linked it meanwhile
+                if (parents[first].compare_exchange_strong(expected, second, std::memory_order_acq_rel)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    template<typename G>
+    Feasibility feasibility(const G &g, size_t threads = ThreadPool::default_threads()) {
+        /**
+        *  @brief Whether g has an Euler path, with a diagnostic when it does not: the unbalanced vertices and
+        *  the number of connected components that have edges (weakly connected ones for directed graphs).
+        *  The degrees take one pass, connectivity one lock-free union-find sweep over the edges on all threads;
+        *  there is no recursion, so long paths are fine.
+        */
+        static_assert(graph::is_graph_v<G>, "feasibility expects a graph");
+
+        size_t n = g.number_of_vertices();
+        bool directed = graph::is_directed(g);
+        const auto in = directed ? detail::in_degrees(g, threads) : std::vector<size_t>();
+        auto result = detail::balance(g, in, threads);
+
+        std::vector<std::atomic<size_t>> parents(n);
+        size_t count = detail::workers_for(n, threads);
+        ThreadPool::parallel_for(n, [&parents](size_t vertex, size_t) {
+            parents[vertex].store(vertex, std::memory_order_relaxed);
+        }, count);
+        ThreadPool::parallel_for(n, [&g, &parents](size_t vertex, size_t) {
+            for (const auto &it : g[vertex]) {
+                detail::unite(parents, vertex, graph::target_of(it));
+            }
+        }, count);
+
+        struct alignas(64) Roots final {
+            size_t count = 0;
+        };
+        std::vector<Roots> roots(count);
+        ThreadPool::parallel_for(n, [&](size_t vertex, size_t worker) {
+            bool edges = !g[vertex].empty() || (directed && in[vertex] > 0);
+            if (edges && parents[vertex].load(std::memory_order_relaxed) == vertex) {
+                ++roots[worker].count;
+            }
+        }, count);
+
+        for (const auto &it : roots) {
+            result.components += it.count;
+        }
+        if (result.components > 1) {
+            result.start = NO_PATH;
+        }
+        return result;
+    }
+}
@@ -1,19 +1,23 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
-#include <list>
-#include <stack>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
 
 #include "../../DataStructures/graph/graph.h"
+#include "euler_path.h"
+#include "feasibility.h"
+#include "parallel_circuit.h"
+#include "tour_file.h"
 
 
 namespace {
-    template <typename T>
-    std::ostream& operator <<(std::ostream& os, const std::list<T>& object) {
-        for (const auto& it : object) {
-            os << it << " ";
-        }
-        return os;
-    }
-
     template <typename T>
     std::ostream& operator <<(std::ostream& os, const std::vector<T>& object) {
         for (const auto& it : object) {
@@ -22,189 +26,92 @@ namespace {
         return os;
     }
 
-    template <typename N>
-    void dfs(const graph::DirectedGraph<N> &target_graph, std::vector<bool> &visited, size_t i) {
-        visited[i] = true;
-        for (const auto& it : target_graph[i]) {
-            if (!visited[static_cast<size_t>(it)]) {
-                dfs(target_graph, visited, static_cast<size_t>(it));
-            }
+    std::ostream& operator <<(std::ostream& os, const Euler::Feasibility& object) {
+        os << object.components << " component(s), unbalanced:";
+        for (const auto& it : object.unbalanced) {
+            os << " " << it.vertex << " (" << it.surplus << ")";
         }
+        return os;
     }
 
-    template <typename N>
-    void dfs(const graph::UndirectedGraph<N> &target_graph, std::vector<bool> &visited, size_t i) {
-        visited[i] = true;
-        for (const auto& it : target_graph[i]) {
-            if (!visited[static_cast<size_t>(it)]) {
-                dfs(target_graph, visited, static_cast<size_t>(it));
-            }
-        }
-    }
-
-    template <typename N>
-    bool checkEulerPath(const graph::UndirectedGraph<N> &target_graph) {
-        if (target_graph.empty()) {
-            return true;
-        }
-
-        size_t oddVertex = 0;
-        for (const auto &it : target_graph) {
-            if (it.size() % 2 == 1) {
-                ++oddVertex;
-            }
-        }
-        if (oddVertex > 2) {
-            return false;
-        }
-
-        std::vector<bool> visited(target_graph.number_of_vertices(), false);
-        for (size_t i = 0, end = target_graph.number_of_vertices(); i < end; ++i) {
-            if (!target_graph[i].empty()) {
-                dfs(target_graph, visited, i);
-                break;
-            }
-        }
-        for (size_t i = 0, end_ = target_graph.number_of_vertices(); i < end_; ++i) {
-            if (!target_graph[i].empty() && !visited[i]) {
-                return false;
-            }
-        }
-
-        return true;
-    }
-
-    template <typename N>
-    bool checkEulerPath(const graph::DirectedGraph<N> &target_graph) {
-        if (target_graph.empty()) {
-            return true;
-        }
-
-        size_t incorrectness = 0;
-        for (size_t i = 0, end = target_graph.number_of_vertices(); i < end; ++i) {
-            int inDegree = 0;
-            for (size_t j = 0; j < end; ++j) {
-                inDegree += std::count_if(target_graph[j].begin(), target_graph[j].end(), [i](const N& node) {
-                    return i == node;
-                });
-            }
-
-            if (std::abs(inDegree - static_cast<int>(target_graph[i].size())) == 1) {
-                ++incorrectness;
-            }
-            if (std::abs(inDegree - static_cast<int>(target_graph[i].size())) > 1 || incorrectness > 2) {
-                return false;
-            }
-        }
-
-        std::vector<bool> visited(target_graph.number_of_vertices(), false);
-        for (size_t i = 0, end = target_graph.number_of_vertices(); i < end; ++i) {
-            if (!target_graph[i].empty()) {
-                dfs(target_graph, visited, i);
-                break;
-            }
-        }
-        for (size_t i = 0, end = target_graph.number_of_vertices(); i < end; ++i) {
-            if (!target_graph[i].empty() && !visited[i]) {
-                return false;
-            }
-        }
-
-        return true;
-    }
-
-    template <typename N>
-    std::vector<size_t> UndirectedEulerPath(graph::UndirectedGraph<N> target_graph) {
-        size_t start = 0;
-        for (size_t i = 0, end = target_graph.number_of_vertices(); i < end; ++i) {
-            if (target_graph[i].size() % 2 == 1) {
-                start = i;
-                break;
-            }
-        }
-
-        std::vector<size_t> result;
-
-        std::stack<size_t> stack;
-        stack.push(start);
-        while (!stack.empty()) {
-            auto vert = stack.top();
-            if (!target_graph[vert].empty()) {
-                stack.push(static_cast<size_t>(target_graph[vert][0]));
-                auto second_arg = target_graph[vert][0];            // necessary because of changed state of g[vert][0] after first
-                                                                    // erase in remove_edge function, which receives the second argument
-                                                                    // as const reference
-                target_graph.remove_edge(vert, second_arg);
-            }
-
-            if (vert == stack.top()) {
-                stack.pop();
-                result.push_back(vert);
-            }
-        }
-
-        return result;
-    }
-
-    template <typename N>
-    std::list<size_t> DirectedEulerPath(graph::DirectedGraph<N> target_graph) {
-        size_t start = 0;
-        for (size_t i = 0, end = target_graph.number_of_vertices(); i < end; ++i) {
-            size_t inDegree = 0;
-            for (size_t j = 0; j < end; ++j) {
-                inDegree += std::count_if(target_graph[j].begin(), target_graph[j].end(), [i](const N& node) {
-                    return i == node;
-                });
-            }
-
-            if (target_graph[i].size() - inDegree == 1) {
-                start = i;
-                break;
+    template<typename G>
+    bool is_euler_circuit(const G& g, const std::vector<size_t>& path) {
+        std::vector<std::pair<size_t, size_t>> edges, walked;
+        for (size_t v = 0; v < g.number_of_vertices(); ++v) {
+            for (const auto& it : g[v]) {
+                if (v <= graph::target_of(it)) {
+                    edges.emplace_back(v, graph::target_of(it));
+                }
             }
         }
-
-        std::list<size_t> result;
-
-        std::stack<size_t> stack;
-        stack.push(start);
-        while (!stack.empty()) {
-            auto vert = stack.top();
-            if (!target_graph[vert].empty()) {
-                stack.push(static_cast<size_t>(target_graph[vert][0]));
-                auto second_arg = target_graph[vert][0];            // necessary because of changed state of g[vert][0] after first
-                                                                    // erase in remove_edge function, which receives the second argument
-                                                                    // as const reference
-                target_graph.remove_edge(vert, second_arg);
-            }
-
-            if (vert == stack.top()) {
-                stack.pop();
-                result.push_front(vert);
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            walked.emplace_back(std::min(path[i], path[i + 1]), std::max(path[i], path[i + 1]));
+            if (walked.back().first == walked.back().second) {      // a loop is listed twice in its row
+                walked.push_back(walked.back());
             }
         }
-
-        return result;
+        std::sort(edges.begin(), edges.end());
+        std::sort(walked.begin(), walked.end());
+        return !path.empty() && path.front() == path.back() && edges == walked;
     }
 }
 
 int main() {
     std::cout << "Undirected graph" << std::endl;
     graph::UndirectedGraph<size_t> undirected_g;
-    undirected_g.generate_random_graph(4, 5);
-    while (!checkEulerPath(undirected_g)) {
-        undirected_g.generate_random_graph(4, 5);
+    uint64_t seed = 0;
+    undirected_g.generate_random_graph(4, 5, seed);
+    std::cout << "First try: " << Euler::feasibility(undirected_g) << std::endl;
+    while (!Euler::feasibility(undirected_g).has_path()) {
+        undirected_g.generate_random_graph(4, 5, ++seed);
     }
     std::cout << undirected_g << std::endl;
-    std::cout << "The Eulerian path is: " << UndirectedEulerPath(undirected_g) << std::endl;
+    std::cout << "The Eulerian path is: " << Euler::euler_path(undirected_g) << std::endl;
 
     std::cout << "Directed graph" << std::endl;
     graph::DirectedGraph<size_t> directed_g;
-    directed_g.generate_random_graph(4, 6);
-    while (!checkEulerPath(directed_g)) {
-        directed_g.generate_random_graph(4, 6);
+    directed_g.generate_random_graph(4, 6, 0, seed);
+    std::cout << "First try: " << Euler::feasibility(directed_g) << std::endl;
+    while (!Euler::feasibility(directed_g).has_path()) {
+        directed_g.generate_random_graph(4, 6, 0, ++seed);
     }
     std::cout << directed_g << std::endl;
-    std::cout << "The Eulerian path is: " << DirectedEulerPath(directed_g) << std::endl;
+    std::cout << "The Eulerian path is: " << Euler::euler_path(directed_g) << std::endl;
+
+    std::cout << "Parallel: " << Euler::parallel_euler_path(directed_g) << std::endl;
+
+    graph::UndirectedGraph<uint32_t> walk_g(20000, false);      // one closed random walk of 400K edges
+    std::mt19937_64 random(seed);
+    for (size_t i = 0, start = random() % 20000, current = start; i < 400000; ++i) {
+        size_t next = i + 1 < 400000 ? random() % 20000 : start;
+        walk_g.add_edge(current, static_cast<uint32_t>(next));
+        current = next;
+    }
+    std::cout << "Parallel undirected circuit on 4 threads is valid: " << std::boolalpha
+              << is_euler_circuit(walk_g, Euler::parallel_euler_path(walk_g, 4)) << std::endl;
+
+    Euler::Hierholzer<decltype(directed_g)> engine(directed_g);
+    std::string tour_path = (std::filesystem::temp_directory_path() / "euler_tour_XXXXXX").string();
+    int fd = ::mkstemp(tour_path.data());
+    if (fd < 0) {
+        std::cerr << "failed to create a temporary tour file" << std::endl;
+        return 1;
+    }
+    ::close(fd);
+    try {
+        Euler::TourWriter writer(tour_path, engine.length());
+        bool streamed = engine.stream(writer);
+        writer.close();
+        if (!streamed) {        // the file has its full length, with holes where the tour stopped
+            throw std::runtime_error("the tour stopped partway");
+        }
+        std::cout << "Streamed to " << tour_path << ": " << Euler::load_tour(tour_path) << std::endl;
+    } catch (std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        std::remove(tour_path.c_str());
+        return 1;
+    }
+    std::remove(tour_path.c_str());
 
     return 0;
 }
@@ -0,0 +1,450 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/thread_pool/thread_pool.h"
+#include "euler_path.h"
+#include "feasibility.h"
+
+
+namespace Euler {
+    namespace detail {
+        class SignedForest final {
+            /**
+            *  @brief Lock-free union-find whose links also carry a parity, packed with the parent into one word:
+            *  parity(x) is the XOR of the bits on the path from x to its root. Links only go from a root to a
+            *  smaller id, and path halving only replaces a link by a fact it implies, so concurrent finds and
+            *  unions stay consistent.
+            */
+            std::vector<std::atomic<size_t>> words;      // parent << 1 | parity to the parent
+
+        public:
+            explicit SignedForest(size_t count, size_t threads) : words(count) {
+                reset(threads);
+            };
+
+            void reset(size_t threads) {
+                ThreadPool::parallel_for(words.size(), [this](size_t i, size_t) {
+                    words[i].store(i << 1u, std::memory_order_relaxed);
+                }, workers_for(words.size(), threads));
+            };
+
+            size_t find(size_t vertex, size_t &parity) {
+                parity = 0;
+                while (true) {
+                    size_t word = words[vertex].load(std::memory_order_acquire), parent = word >> 1u;
+                    if (parent == vertex) {
+                        return vertex;
+                    }
+                    size_t above = words[parent].load(std::memory_order_acquire);
+                    if (above >> 1u != parent) {
+                        words[vertex].compare_exchange_weak(word, (above & ~size_t(1)) | ((word ^ above) & 1u),
+                                                            std::memory_order_acq_rel);
+                    }
+                    parity ^= (word ^ above) & 1u;
+                    vertex = above >> 1u;
+                }
+            };
+
+            bool unite(size_t first, size_t second, size_t parity) {
+                /**
+                *  @brief Records parity(first) ^ parity(second) == parity; true if this call joined two sets.
+                */
+                while (true) {
+                    size_t first_parity, second_parity;
+                    first = find(first, first_parity);
+                    second = find(second, second_parity);
+                    if (first == second) {
+                        return false;
+                    }
+                    if (first < second) {
+                        std::swap(first, second);
+                    }
+
+                    size_t expected = first << 1u;
+                    size_t link = second << 1u | (first_parity ^ second_parity ^ parity);
+                    if (words[first].compare_exchange_strong(expected, link, std::memory_order_acq_rel)) {
+                        return true;
+                    }
+                }
+            };
+        };
+    }
+
+    template<typename G>
+    class CycleSplicing final {
+        /**
+        *  @brief Parallel Euler circuit for very large balanced graphs, in four parallel sweeps:
+        *  1. every vertex pairs each edge that enters it with one that leaves it (in an undirected graph, slot
+        *     2i with slot 2i + 1 of its row, which starts at an even slot since degrees are even); following
+        *     the pairs splits the edges into disjoint closed trails;
+        *  2. threads walk the trails from unclaimed edges and claim edges by CAS until they run into a claimed
+        *     one, whose segment they join in a union-find; undirected segments may run against each other or
+        *     apart, so a pass over the pairs joins them too and the union-find tracks which to reverse;
+        *  3. every vertex splices the cycles through it by swapping successors of two entering edges, which
+        *     merges their cycles whenever a union-find over cycles reports them apart: the successful links
+        *     form a spanning forest, so every swap merges, in whatever order the threads apply them;
+        *  4. list ranking from evenly spaced splitters writes the final cycle into the output.
+        *  The result obeys the guarantees of Hierholzer::path; graphs with an Euler path but no circuit are
+        *  handed to Hierholzer. With several threads the circuit found may differ between runs.
+        */
+        static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+        static constexpr size_t SPLITTERS = 64;         // per worker in the ranking sweep
+
+        const G &g;
+        size_t threads;
+        bool directed;
+        std::vector<size_t> offsets;        // slots of vertex v are offsets[v] .. offsets[v + 1] - 1
+        std::vector<size_t> edge_ids;       // undirected only: slot -> edge
+        std::vector<size_t> ends;           // undirected only: the two slots of edge e at 2e and 2e + 1
+        std::vector<size_t> in_offsets;     // directed only: edges entering v, by slot
+        std::vector<size_t> in_edges;
+        std::vector<size_t> successors;     // edge -> next edge of its cycle
+        std::vector<size_t> tails;          // edge -> vertex it leaves
+        std::vector<std::atomic<size_t>> labels;        // edge -> segment << 1 | reversed, later cycle << 1 | reversed
+
+        size_t workers_for(size_t work) const {
+            return detail::workers_for(work, threads);
+        };
+
+        size_t number_of_edges() const {
+            return directed ? offsets.back() : offsets.back() / 2;
+        };
+
+        size_t head_slot(size_t edge) const {
+            return ends[2 * edge + 1 - (labels[edge].load(std::memory_order_relaxed) & 1u)];
+        };
+
+        void decompose();
+
+        size_t label(detail::SignedForest &forest);
+
+        void orient(detail::SignedForest &forest);
+
+        size_t splice(detail::SignedForest &forest);
+
+        void rank(size_t first, std::vector<size_t> &result) const;
+
+    public:
+        explicit CycleSplicing(const G &new_g, size_t new_threads = ThreadPool::default_threads());
+
+        bool path(std::vector<size_t> &result);
+
+        std::vector<size_t> path();
+    };
+
+    template<typename G>
+    CycleSplicing<G>::CycleSplicing(const G &new_g, size_t new_threads) : g(new_g),
+                                                                          threads(std::max<size_t>(1, new_threads)),
+                                                                          directed(graph::is_directed(new_g)) {
+        static_assert(graph::is_graph_v<G>, "CycleSplicing expects a graph");
+    }
+
+    template<typename G>
+    void CycleSplicing<G>::decompose() {
+        /**
+        *  @brief Sweep 1: the successor of every edge. Directed graphs gather the entering edges of every
+        *  vertex, sorted by slot so the result does not depend on the threads, and pair the k-th of them with
+        *  the k-th leaving edge; undirected pairs are implicit in the slot numbering.
+        */
+        size_t n = g.number_of_vertices(), edges = number_of_edges();
+        successors.resize(edges);
+        tails.resize(edges);
+        labels = std::vector<std::atomic<size_t>>(edges);
+        ThreadPool::parallel_for(edges, [this](size_t i, size_t) {
+            labels[i].store(NONE, std::memory_order_relaxed);
+        }, workers_for(edges));
+
+        if (!directed) {
+            detail::pair_slots(g, offsets, edge_ids, &ends);
+            return;
+        }
+
+        const auto in = detail::in_degrees(g, threads);
+        in_offsets.assign(n + 1, 0);
+        for (size_t v = 0; v < n; ++v) {
+            in_offsets[v + 1] = in_offsets[v] + in[v];
+        }
+        std::vector<std::atomic<size_t>> fill(n);
+        ThreadPool::parallel_for(n, [&](size_t v, size_t) {
+            fill[v].store(in_offsets[v], std::memory_order_relaxed);
+        }, workers_for(n));
+
+        in_edges.resize(edges);
+        ThreadPool::parallel_for(n, [&](size_t v, size_t) {
+            const auto &row = g[v];
+            for (size_t i = 0, end_ = row.size(); i < end_; ++i) {
+                size_t target = graph::target_of(row[i]);
+                in_edges[fill[target].fetch_add(1, std::memory_order_relaxed)] = offsets[v] + i;
+                tails[offsets[v] + i] = v;
+            }
+        }, workers_for(n));
+
+        ThreadPool::parallel_for(n, [this](size_t v, size_t) {
+            std::sort(in_edges.begin() + static_cast<std::ptrdiff_t>(in_offsets[v]),
+                      in_edges.begin() + static_cast<std::ptrdiff_t>(in_offsets[v + 1]));
+            for (size_t k = 0, end_ = in_offsets[v + 1] - in_offsets[v]; k < end_; ++k) {
+                successors[in_edges[in_offsets[v] + k]] = offsets[v] + k;
+            }
+        }, workers_for(n));
+    }
+
+    template<typename G>
+    size_t CycleSplicing<G>::label(detail::SignedForest &forest) {
+        /**
+        *  @brief Sweep 2: claims every edge for a segment of its trail and joins segments that meet, then, in an
+        *  undirected graph, joins the segments on the two edges of every pair. Returns the number of cycles. A
+        *  label keeps whether the segment crossed the edge from its second slot, so one CAS publishes both.
+        */
+        size_t edges = number_of_edges();
+        struct alignas(64) Worker final {
+            size_t cycles = 0;
+        };
+        std::vector<Worker> workers(workers_for(edges));
+
+        ThreadPool::parallel_for(edges, [&](size_t start, size_t worker) {
+            size_t expected = NONE;
+            if (labels[start].load(std::memory_order_relaxed) != NONE ||
+                !labels[start].compare_exchange_strong(expected, start << 1u, std::memory_order_acq_rel)) {
+                return;
+            }
+            ++workers[worker].cycles;       // every segment starts a set, every successful union removes one
+
+            size_t edge = start, reversed = 0;
+            while (true) {
+                size_t next, next_reversed = 0;
+                if (directed) {
+                    next = successors[edge];
+                } else {
+                    size_t slot = ends[2 * edge + 1 - reversed] ^ 1u;      // the slot paired with the head
+                    next = edge_ids[slot];
+                    next_reversed = ends[2 * next] != slot;
+                }
+
+                expected = NONE;
+                if (labels[next].compare_exchange_strong(expected, start << 1u | next_reversed,
+                                                         std::memory_order_acq_rel)) {
+                    edge = next;
+                    reversed = next_reversed;
+                    continue;
+                }
+                if (forest.unite(start, expected >> 1u, (expected ^ next_reversed) & 1u)) {
+                    --workers[worker].cycles;
+                }
+                return;
+            }
+        }, workers.size());
+
+        if (!directed) {
+            // two segments may also start on the edges of one pair and walk away from each other, which no CAS
+            // above sees; of a pair, exactly one edge must enter through its slot
+            ThreadPool::parallel_for(edges, [&](size_t pair, size_t worker) {
+                size_t slot = 2 * pair, first = edge_ids[slot], second = edge_ids[slot + 1];
+                size_t first_word = labels[first].load(std::memory_order_relaxed);
+                size_t second_word = labels[second].load(std::memory_order_relaxed);
+                size_t parity = (1u ^ first_word ^ second_word ^ (ends[2 * first] == slot) ^
+                                 (ends[2 * second] == slot + 1)) & 1u;
+                if (forest.unite(first_word >> 1u, second_word >> 1u, parity)) {
+                    --workers[worker].cycles;
+                }
+            }, workers.size());
+        }
+
+        size_t cycles = 0;
+        for (const auto &it : workers) {
+            cycles += it.cycles;
+        }
+        return cycles;
+    }
+
+    template<typename G>
+    void CycleSplicing<G>::orient(detail::SignedForest &forest) {
+        /**
+        *  @brief Relabels every edge with its cycle and, in an undirected graph, turns the edges of reversed
+        *  segments around and derives tails and successors.
+        */
+        size_t edges = number_of_edges();
+        ThreadPool::parallel_for(edges, [&](size_t edge, size_t) {
+            size_t word = labels[edge].load(std::memory_order_relaxed), parity;
+            size_t cycle = forest.find(word >> 1u, parity);
+            labels[edge].store(cycle << 1u | ((word ^ parity) & 1u), std::memory_order_relaxed);
+        }, workers_for(edges));
+
+        if (directed) {
+            return;
+        }
+
+        size_t n = g.number_of_vertices();
+        ThreadPool::parallel_for(n, [this](size_t v, size_t) {
+            for (size_t slot = offsets[v]; slot < offsets[v + 1]; ++slot) {
+                size_t edge = edge_ids[slot];
+                if (head_slot(edge) != slot) {
+                    tails[edge] = v;
+                    successors[edge] = edge_ids[head_slot(edge) ^ 1u];
+                }
+            }
+        }, workers_for(n));
+    }
+
+    template<typename G>
+    size_t CycleSplicing<G>::splice(detail::SignedForest &forest) {
+        /**
+        *  @brief Sweep 3: at every vertex, joins the cycle of the first entering edge with the cycles of the
+        *  others. Every vertex swaps only successors of its own entering edges, so the threads never write
+        *  the same entry. Returns the number of successful joins.
+        */
+        struct alignas(64) Worker final {
+            size_t joins = 0;
+            std::vector<size_t> entering;
+        };
+        size_t n = g.number_of_vertices();
+        std::vector<Worker> workers(workers_for(n));
+
+        ThreadPool::parallel_for(n, [&](size_t v, size_t worker) {
+            auto &entering = workers[worker].entering;
+            entering.clear();
+            if (directed) {
+                entering.assign(in_edges.begin() + static_cast<std::ptrdiff_t>(in_offsets[v]),
+                                in_edges.begin() + static_cast<std::ptrdiff_t>(in_offsets[v + 1]));
+            } else {
+                for (size_t slot = offsets[v]; slot < offsets[v + 1]; ++slot) {
+                    if (head_slot(edge_ids[slot]) == slot) {
+                        entering.push_back(edge_ids[slot]);
+                    }
+                }
+            }
+
+            for (size_t i = 1; i < entering.size(); ++i) {
+                size_t first = entering[0], other = entering[i];
+                if (forest.unite(labels[first].load(std::memory_order_relaxed) >> 1u,
+                                 labels[other].load(std::memory_order_relaxed) >> 1u, 0)) {
+                    std::swap(successors[first], successors[other]);
+                    ++workers[worker].joins;
+                }
+            }
+        }, workers.size());
+
+        size_t joins = 0;
+        for (const auto &it : workers) {
+            joins += it.joins;
+        }
+        return joins;
+    }
+
+    template<typename G>
+    void CycleSplicing<G>::rank(size_t first, std::vector<size_t> &result) const {
+        /**
+        *  @brief Sweep 4: cuts the circuit at evenly spaced splitter edges, measures the pieces in parallel,
+        *  places them one after the other starting from first, and writes them in parallel.
+        */
+        size_t edges = number_of_edges();
+        size_t stride = std::max<size_t>(1, edges / (workers_for(edges) * SPLITTERS));
+        std::vector<size_t> splitters;
+        for (size_t i = 0; i < edges; i += stride) {
+            splitters.push_back(i);
+        }
+        if (first % stride != 0) {
+            splitters.insert(std::upper_bound(splitters.begin(), splitters.end(), first), first);
+        }
+        std::vector<uint64_t> marks((edges + 63) / 64, 0);
+        for (const auto &it : splitters) {
+            marks[it / 64] |= uint64_t(1) << (it % 64);
+        }
+
+        size_t count = splitters.size();
+        std::vector<size_t> lengths(count), nexts(count), positions(count);
+        ThreadPool::parallel_for(count, [&](size_t i, size_t) {
+            size_t edge = splitters[i], length = 0;
+            do {
+                ++length;
+                edge = successors[edge];
+            } while (!(marks[edge / 64] >> (edge % 64) & 1u));
+            lengths[i] = length;
+            nexts[i] = static_cast<size_t>(std::lower_bound(splitters.begin(), splitters.end(), edge) -
+                                           splitters.begin());
+        }, std::min(threads, count));
+
+        size_t piece = static_cast<size_t>(std::lower_bound(splitters.begin(), splitters.end(), first) -
+                                           splitters.begin());
+        for (size_t i = 0, position = 0; i < count; ++i, piece = nexts[piece]) {
+            positions[piece] = position;
+            position += lengths[piece];
+        }
+
+        ThreadPool::parallel_for(count, [&](size_t i, size_t) {
+            size_t edge = splitters[i];
+            for (size_t k = 0; k < lengths[i]; ++k, edge = successors[edge]) {
+                result[positions[i] + k] = tails[edge];
+            }
+        }, std::min(threads, count));
+        result[edges] = result[0];
+    }
+
+    template<typename G>
+    bool CycleSplicing<G>::path(std::vector<size_t> &result) {
+        /**
+        *  @brief Writes an Euler circuit into result as E + 1 vertices, starting where Hierholzer would start.
+        *  Returns false and leaves result empty if the graph has no Euler path.
+        */
+        result.clear();
+        const auto feasible = feasibility(g, threads);
+        if (!feasible.has_path()) {
+            return false;
+        }
+        if (!feasible.has_circuit()) {
+            return Hierholzer<G>(g).path(result);
+        }
+
+        size_t n = g.number_of_vertices();
+        offsets.assign(n + 1, 0);
+        for (size_t v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + g[v].size();
+        }
+        size_t edges = number_of_edges();
+        if (edges == 0) {
+            result.assign(1, feasible.start);
+            return true;
+        }
+
+        decompose();
+        detail::SignedForest forest(edges, threads);
+        size_t cycles = label(forest);
+        orient(forest);
+        forest.reset(threads);
+        if (splice(forest) + 1 != cycles) {     // cannot happen after the feasibility check, but cheap to see
+            return false;
+        }
+
+        size_t first = NONE;
+        for (size_t slot = offsets[feasible.start]; first == NONE; ++slot) {
+            size_t edge = directed ? slot : edge_ids[slot];
+            if (tails[edge] == feasible.start) {
+                first = edge;
+            }
+        }
+
+        result.resize(edges + 1);
+        rank(first, result);
+        return true;
+    }
+
+    template<typename G>
+    std::vector<size_t> CycleSplicing<G>::path() {
+        std::vector<size_t> result;
+        path(result);
+        return result;
+    }
+
+    template<typename G>
+    std::vector<size_t> parallel_euler_path(const G &g, size_t threads = ThreadPool::default_threads()) {
+        /**
+        *  @brief One-shot parallel Euler circuit, or path through Hierholzer; empty if the graph has none.
+        */
+        return CycleSplicing<G>(g, threads).path();
+    }
+}
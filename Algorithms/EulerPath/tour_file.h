@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../../DataStructures/graph/graph_file.h"
+
+/*
+ * Tour file layout (native byte order):
+ *
+ *   TourHeader
+ *   uint64_t vertices[header.vertices]      the Euler path in order
+ *
+ * Both writers take the sink(position, vertex) calls of Hierholzer::stream, which arrive back to front,
+ * and put every vertex at its final place, so the file is complete once the stream returns true.
+ */
+namespace Euler {
+    namespace file {
+        constexpr char MAGIC[8] = {'A', 'D', 'S', 'E', 'T', 'O', 'U', 'R'};
+
+        struct TourHeader final {
+            char magic[8];
+            uint64_t vertices;
+        };
+
+        inline int create(const std::string &path, uint64_t vertices) {
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                throw std::runtime_error("failed to create tour file " + path);
+            }
+
+            TourHeader header{};
+            std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+            header.vertices = vertices;
+            if (::ftruncate(fd, static_cast<off_t>(sizeof(header) + vertices * sizeof(uint64_t))) != 0 ||
+                ::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+                ::close(fd);
+                throw std::runtime_error("failed to write tour file " + path);
+            }
+            return fd;
+        }
+    }
+
+    class TourWriter final {
+        /**
+        *  @brief Tour file sink over pwrite: vertices gather back to front in a fixed block that is written out
+        *  whenever it fills up, so memory stays at one block however long the tour is.
+        */
+        static constexpr size_t BLOCK = 1u << 16u;
+
+        std::string path;
+        int fd;
+        std::vector<uint64_t> buffer;
+        size_t filled;
+        size_t lowest;      // position of buffer[BLOCK - filled]
+
+        void flush() {
+            const char *from = reinterpret_cast<const char *>(buffer.data() + BLOCK - filled);
+            size_t bytes = filled * sizeof(uint64_t);
+            auto offset = static_cast<off_t>(sizeof(file::TourHeader) + lowest * sizeof(uint64_t));
+            while (bytes) {
+                ssize_t written = ::pwrite(fd, from, bytes, offset);
+                if (written <= 0) {
+                    throw std::runtime_error("failed to write tour file " + path);
+                }
+                from += written;
+                bytes -= static_cast<size_t>(written);
+                offset += written;
+            }
+            filled = 0;
+        };
+
+    public:
+        TourWriter(const std::string &new_path, size_t vertices) : path(new_path),
+                                                                   fd(file::create(new_path, vertices)),
+                                                                   buffer(BLOCK), filled(0), lowest(0) {};
+
+        TourWriter(const TourWriter &other) = delete;
+
+        TourWriter &operator=(const TourWriter &other) = delete;
+
+        ~TourWriter() noexcept {
+            if (fd >= 0) {
+                try {
+                    flush();
+                } catch (...) {}
+                ::close(fd);
+            }
+        };
+
+        void operator ()(size_t position, size_t vertex) {
+            if (filled == BLOCK || (filled && position + 1 != lowest)) {
+                flush();
+            }
+            buffer[BLOCK - ++filled] = vertex;
+            lowest = position;
+        };
+
+        void close() {
+            /**
+            *  @brief Writes what is left and closes the file; unlike the destructor, reports failures.
+            */
+            if (fd < 0) {
+                return;
+            }
+            flush();
+            int result = ::close(fd);
+            fd = -1;
+            if (result != 0) {
+                throw std::runtime_error("failed to write tour file " + path);
+            }
+        };
+    };
+
+    class MappedTourWriter final {
+        /**
+        *  @brief Tour file sink over a shared writable mapping: every vertex is stored straight into the page
+        *  of its position and the kernel writes pages back on its own, so resident memory is page cache only.
+        */
+        std::string path;
+        void *address;
+        size_t length;
+        uint64_t *vertices;
+
+    public:
+        MappedTourWriter(const std::string &new_path, size_t count) : path(new_path), address(nullptr),
+                                                                       length(sizeof(file::TourHeader) +
+                                                                              count * sizeof(uint64_t)),
+                                                                       vertices(nullptr) {
+            int fd = file::create(path, count);
+            address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);        // the mapping keeps its own reference to the file
+            if (address == MAP_FAILED) {
+                address = nullptr;
+                throw std::runtime_error("failed to map " + path);
+            }
+            vertices = reinterpret_cast<uint64_t *>(static_cast<char *>(address) + sizeof(file::TourHeader));
+        };
+
+        MappedTourWriter(const MappedTourWriter &other) = delete;
+
+        MappedTourWriter &operator=(const MappedTourWriter &other) = delete;
+
+        ~MappedTourWriter() noexcept {
+            if (address) {
+                ::munmap(address, length);
+            }
+        };
+
+        void operator ()(size_t position, size_t vertex) {
+            vertices[position] = vertex;
+        };
+
+        void close() {
+            /**
+            *  @brief Waits until the pages are on disk and unmaps them.
+            */
+            if (!address) {
+                return;
+            }
+            int result = ::msync(address, length, MS_SYNC);
+            ::munmap(address, length);
+            address = nullptr;
+            if (result != 0) {
+                throw std::runtime_error("failed to write tour file " + path);
+            }
+        };
+    };
+
+    inline std::vector<size_t> load_tour(const std::string &path) {
+        graph::MappedFile mapping(path);
+        file::TourHeader header{};
+        if (mapping.size() < sizeof(header)) {
+            throw std::runtime_error("truncated tour file " + path);
+        }
+        std::memcpy(&header, mapping.data(), sizeof(header));
+        if (std::memcmp(header.magic, file::MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("not a tour file " + path);
+        }
+        if (mapping.size() != sizeof(header) + header.vertices * sizeof(uint64_t)) {
+            throw std::runtime_error("truncated tour file " + path);
+        }
+
+        std::vector<size_t> result(header.vertices);
+        for (size_t i = 0; i < result.size(); ++i) {
+            uint64_t vertex;
+            std::memcpy(&vertex, mapping.data() + sizeof(header) + i * sizeof(uint64_t), sizeof(vertex));
+            result[i] = static_cast<size_t>(vertex);
+        }
+        return result;
+    }
+}
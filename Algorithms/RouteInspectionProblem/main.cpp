@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/graph/graph_text_io.h"
+#include "route_inspection.h"
+
+
+namespace {
+    using Graph = graph::DirectedGraph<graph::Node>;
+
+    struct Options final {
+        bool from_input = false;
+        size_t n = 10;
+        size_t e = 20;
+        uint64_t seed = 11;
+    };
+
+    void usage(const char *name) {
+        std::cerr << "usage: " << name << " [-i | --from-input] [-n VERTICES] [-e EDGES] [-s SEED]\n"
+                  << "Solve Route Inspection (Chinese Postman) Problem.\n"
+                  << "  -i, --from-input  read the graph as \"1: 2 (w) 3 (w) ; 2: ...\" from the standard input;\n"
+                  << "                    if not provided, generates a random graph\n"
+                  << "  -n                number of vertices for random graph case (by default 10)\n"
+                  << "  -e                number of edges for random graph case (by default 20)\n"
+                  << "  -s                seed for random graph case (by default 11)" << std::endl;
+    }
+
+    Options parse_options(int argc, char **argv) {
+        Options result;
+        for (int i = 1; i < argc; ++i) {
+            std::string flag = argv[i];
+            if (flag == "-i" || flag == "--from-input") {
+                result.from_input = true;
+                continue;
+            }
+            if ((flag != "-n" && flag != "-e" && flag != "-s") || i + 1 == argc) {
+                throw std::invalid_argument("option " + flag);
+            }
+
+            size_t value = std::stoull(argv[++i]);
+            if (flag == "-n") {
+                result.n = value;
+            } else if (flag == "-e") {
+                result.e = value;
+            } else {
+                result.seed = value;
+            }
+        }
+        return result;
+    }
+
+    std::ostream &operator<<(std::ostream &os, const std::vector<RouteInspection::Step> &tour) {
+        os << "[";
+        for (size_t i = 0; i < tour.size(); ++i) {
+            os << (i ? ", (" : "(") << tour[i].vertex + 1 << ", " << tour[i].weight << ")";
+        }
+        return os << "]";
+    }
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (std::exception &) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Graph g;
+    try {
+        if (options.from_input) {
+            std::string line;
+            std::cout << "Graph: " << std::flush;
+            std::getline(std::cin, line);
+            g = graph::text::parse_directed<graph::Node>(line.data(), line.data() + line.size(),
+                                                         graph::text::Format::ADJACENCY);
+        } else {
+            g = RouteInspection::random_connected_graph<graph::Node>(options.n, options.e, options.seed);
+        }
+    } catch (std::exception &error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    RouteInspection::Route route;
+    try {
+        route = RouteInspection::rip(g);
+    } catch (std::runtime_error &) {
+        std::cout << "Graph must be fully-connected" << std::endl;
+        return 1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+    std::cout << "Tour: " << route.tour << std::endl;
+    std::cout << "Cost of tour: " << route.cost << std::endl;
+    std::cout << "Overhead: " << route.overhead << std::endl;
+    std::cout << "Time elapsed: " << elapsed.count() << "s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../../DataStructures/graph/graph.h"
+#include "../../DataStructures/graph/graph_generators.h"
+#include "../EulerPath/euler_path.h"
+
+
+namespace RouteInspection {
+    struct Step final {
+        size_t vertex;
+        size_t weight;      // of the edge that led to vertex, 0 for the start
+    };
+
+    struct Route final {
+        std::vector<Step> tour;     // closed: the last vertex is the first one
+        size_t cost;                // weight of the whole tour
+        size_t overhead;            // weight of the edges walked more than once
+    };
+
+    template<typename G>
+    class Transport final {
+        /**
+        *  @brief Cheapest set of edge copies that balances a directed graph: a min-cost flow from the vertices with
+        *  more entries than exits to those with more exits, through uncapacitated edges. Replaces Floyd-Warshall
+        *  with the Hungarian method over all pairs of unbalanced vertices (O(V^3) time, O(V^2) memory) by the
+        *  primal network simplex on the graph itself. The spanning tree starts from artificial arcs of cost
+        *  (max weight + 1) * (V + 1) between every vertex and an extra root, entering arcs are chosen by block
+        *  search over about sqrt(E) arcs at a time, and leaving arcs by the strongly feasible rule, so
+        *  degenerate pivots cannot cycle. Edges have no capacity, so a non-tree arc always carries no flow.
+        *  The tree is kept as parents with depths and child lists: a pivot walks the cycle it closes and
+        *  re-hangs, with new depths and potentials, only the subtree cut off by the leaving arc.
+        */
+        static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+        const G &g;
+        size_t n;
+        size_t edges;
+        size_t root;
+        std::vector<size_t> tails;          // arc -> vertex it leaves: edges by slot, then one artificial per vertex
+        std::vector<size_t> heads;
+        std::vector<int64_t> costs;
+        std::vector<int64_t> flows;
+        std::vector<char> in_tree;
+        std::vector<int64_t> potentials;    // reduced cost of arc (u, v) is cost + potential[u] - potential[v]
+        std::vector<size_t> parents;
+        std::vector<size_t> parent_arcs;
+        std::vector<size_t> depths;
+        std::vector<size_t> first_child;
+        std::vector<size_t> next_sibling;
+        std::vector<size_t> prev_sibling;
+        std::vector<size_t> tail_side;      // the cycle of a pivot: from the tail of the entering arc up to the join
+        std::vector<size_t> head_side;      // and from its head
+        std::vector<size_t> stack;
+        size_t next_arc;
+        size_t block;
+        std::vector<size_t> copies;
+
+        int64_t reduced_cost(size_t arc) const {
+            return costs[arc] + potentials[tails[arc]] - potentials[heads[arc]];
+        };
+
+        bool points_up(size_t vertex) const {       // the tree arc of vertex leads to its parent
+            return tails[parent_arcs[vertex]] == vertex;
+        };
+
+        void attach(size_t vertex, size_t parent, size_t arc) {
+            parents[vertex] = parent;
+            parent_arcs[vertex] = arc;
+            prev_sibling[vertex] = NONE;
+            next_sibling[vertex] = first_child[parent];
+            if (first_child[parent] != NONE) {
+                prev_sibling[first_child[parent]] = vertex;
+            }
+            first_child[parent] = vertex;
+        };
+
+        void detach(size_t vertex) {
+            if (prev_sibling[vertex] != NONE) {
+                next_sibling[prev_sibling[vertex]] = next_sibling[vertex];
+            } else {
+                first_child[parents[vertex]] = next_sibling[vertex];
+            }
+            if (next_sibling[vertex] != NONE) {
+                prev_sibling[next_sibling[vertex]] = prev_sibling[vertex];
+            }
+        };
+
+        size_t entering_arc();
+
+        void pivot(size_t arc);
+
+    public:
+        explicit Transport(const G &new_g);
+
+        const std::vector<size_t> &solve();
+
+        [[nodiscard]] size_t cost() const;
+    };
+
+    template<typename G>
+    Transport<G>::Transport(const G &new_g) : g(new_g), n(new_g.number_of_vertices()), edges(0),
+                                              root(new_g.number_of_vertices()), next_arc(0), block(0) {
+        static_assert(graph::is_graph_v<G>, "Transport expects a graph");
+        if (!graph::is_directed(g)) {
+            throw std::invalid_argument("graph must be directed");
+        }
+
+        for (size_t v = 0; v < n; ++v) {
+            edges += g[v].size();
+        }
+        tails.resize(edges + n);
+        heads.resize(edges + n);
+        costs.resize(edges + n);
+        flows.assign(edges + n, 0);
+        in_tree.assign(edges + n, 0);
+
+        int64_t heaviest = 0;
+        std::vector<int64_t> surplus(n, 0);     // entries minus exits
+        for (size_t v = 0, slot = 0; v < n; ++v) {
+            for (const auto &it : g[v]) {
+                tails[slot] = v;
+                heads[slot] = graph::target_of(it);
+                costs[slot] = static_cast<int64_t>(graph::weight_of(it));
+                heaviest = std::max(heaviest, costs[slot]);
+                --surplus[v];
+                ++surplus[heads[slot]];
+                ++slot;
+            }
+        }
+
+        potentials.assign(n + 1, 0);
+        parents.assign(n + 1, NONE);
+        parent_arcs.assign(n + 1, NONE);
+        depths.assign(n + 1, 0);
+        first_child.assign(n + 1, NONE);
+        next_sibling.assign(n + 1, NONE);
+        prev_sibling.assign(n + 1, NONE);
+
+        int64_t artificial = (heaviest + 1) * static_cast<int64_t>(n + 1);     // dearer than any simple path
+        for (size_t v = 0; v < n; ++v) {
+            size_t arc = edges + v;
+            costs[arc] = artificial;
+            in_tree[arc] = 1;
+            if (surplus[v] >= 0) {      // zero-flow tree arcs must point up for a strongly feasible tree
+                tails[arc] = v;
+                heads[arc] = root;
+                flows[arc] = surplus[v];
+                potentials[v] = -artificial;
+            } else {
+                tails[arc] = root;
+                heads[arc] = v;
+                flows[arc] = -surplus[v];
+                potentials[v] = artificial;
+            }
+            depths[v] = 1;
+            attach(v, root, arc);
+        }
+    }
+
+    template<typename G>
+    size_t Transport<G>::entering_arc() {
+        /**
+        *  @brief Block search: scans arcs cyclically from where the last search stopped and returns the most
+        *  negative reduced cost of the first block that has one, NONE once a whole round finds none.
+        */
+        size_t total = tails.size();
+        if (block == 0) {
+            block = std::max<size_t>(10, static_cast<size_t>(std::sqrt(static_cast<double>(total))));
+        }
+
+        size_t chosen = NONE, scanned = 0;
+        int64_t best = 0;
+        for (size_t i = 0; i < total; ++i) {
+            size_t arc = next_arc;
+            next_arc = next_arc + 1 == total ? 0 : next_arc + 1;
+            if (!in_tree[arc] && reduced_cost(arc) < best) {
+                best = reduced_cost(arc);
+                chosen = arc;
+            }
+            if (++scanned == block) {
+                if (chosen != NONE) {
+                    return chosen;
+                }
+                scanned = 0;
+            }
+        }
+        return chosen;
+    }
+
+    template<typename G>
+    void Transport<G>::pivot(size_t arc) {
+        /**
+        *  @brief Sends flow around the cycle that arc closes with the tree, in the direction of arc, until the
+        *  first tree arc that runs against it empties. Ties go to the last such arc after the join, which
+        *  keeps the tree strongly feasible. That arc leaves, and the subtree it held is re-hung from arc.
+        */
+        size_t tail = tails[arc], head = heads[arc];
+        tail_side.clear();
+        head_side.clear();
+        for (size_t u = tail, v = head; u != v;) {
+            if (depths[u] >= depths[v]) {
+                tail_side.push_back(u);
+                u = parents[u];
+            } else {
+                head_side.push_back(v);
+                v = parents[v];
+            }
+        }
+
+        // the cycle runs from the join down to tail, over arc, then from head up to the join
+        int64_t delta = std::numeric_limits<int64_t>::max();
+        size_t leaving = NONE;
+        bool on_head_side = false;
+        for (const auto &it : tail_side) {
+            if (points_up(it) && flows[parent_arcs[it]] < delta) {
+                delta = flows[parent_arcs[it]];
+                leaving = it;
+            }
+        }
+        for (const auto &it : head_side) {
+            if (!points_up(it) && flows[parent_arcs[it]] <= delta) {
+                delta = flows[parent_arcs[it]];
+                leaving = it;
+                on_head_side = true;
+            }
+        }
+
+        if (delta > 0) {
+            flows[arc] += delta;
+            for (const auto &it : tail_side) {
+                flows[parent_arcs[it]] += points_up(it) ? -delta : delta;
+            }
+            for (const auto &it : head_side) {
+                flows[parent_arcs[it]] += points_up(it) ? delta : -delta;
+            }
+        }
+        in_tree[parent_arcs[leaving]] = 0;
+        in_tree[arc] = 1;
+
+        // the path from the endpoint below the leaving arc up to it turns around and hangs from the other endpoint
+        size_t vertex = on_head_side ? head : tail;
+        int64_t shift = on_head_side ? reduced_cost(arc) : -reduced_cost(arc);
+        for (size_t parent = on_head_side ? tail : head, parent_arc = arc;;) {
+            size_t old_parent = parents[vertex], old_arc = parent_arcs[vertex];
+            detach(vertex);
+            attach(vertex, parent, parent_arc);
+            if (vertex == leaving) {
+                break;
+            }
+            parent = vertex;
+            parent_arc = old_arc;
+            vertex = old_parent;
+        }
+
+        stack.assign(1, on_head_side ? head : tail);
+        while (!stack.empty()) {
+            size_t top = stack.back();
+            stack.pop_back();
+            potentials[top] += shift;
+            depths[top] = depths[parents[top]] + 1;
+            for (size_t child = first_child[top]; child != NONE; child = next_sibling[child]) {
+                stack.push_back(child);
+            }
+        }
+    }
+
+    template<typename G>
+    const std::vector<size_t> &Transport<G>::solve() {
+        /**
+        *  @brief Extra copies per edge slot, slots numbered row by row. Throws if flow is left on an artificial
+        *  arc, that is if some vertex with more entries than exits cannot reach one with more exits and no
+        *  closed route covers every edge.
+        */
+        for (size_t arc = entering_arc(); arc != NONE; arc = entering_arc()) {
+            pivot(arc);
+        }
+        for (size_t v = 0; v < n; ++v) {
+            if (flows[edges + v] != 0) {
+                throw std::runtime_error("graph must be strongly connected");
+            }
+        }
+
+        copies.assign(flows.begin(), flows.begin() + static_cast<std::ptrdiff_t>(edges));
+        return copies;
+    }
+
+    template<typename G>
+    size_t Transport<G>::cost() const {
+        size_t result = 0;
+        for (size_t slot = 0; slot < copies.size(); ++slot) {
+            result += copies[slot] * static_cast<size_t>(costs[slot]);
+        }
+        return result;
+    }
+
+    template<typename N>
+    Route rip(const graph::DirectedGraph<N> &g) {
+        /**
+        *  @brief Shortest closed route over a directed graph that walks every edge at least once (the Chinese
+        *  postman problem): Transport decides which edges to walk again, Hierholzer walks the resulting Eulerian
+        *  graph. Parallel edges of different weights are told apart by handing out, for every step u -> v, the
+        *  lightest copy of u -> v not used yet; the tour walks each of them once, so the cost is exact. Throws
+        *  if there is no such route.
+        */
+        Transport<graph::DirectedGraph<N>> transport(g);
+        const auto &copies = transport.solve();
+
+        graph::DirectedGraph<N> augmented(g);
+        for (size_t v = 0, slot = 0, n = g.number_of_vertices(); v < n; ++v) {
+            for (const auto &it : g[v]) {
+                for (size_t i = 0; i < copies[slot]; ++i) {
+                    augmented.add_edge(v, it);
+                }
+                ++slot;
+            }
+        }
+
+        std::vector<size_t> vertices;
+        if (!Euler::Hierholzer<graph::DirectedGraph<N>>(augmented).path(vertices)) {
+            throw std::runtime_error("graph must be strongly connected");
+        }
+
+        size_t n = augmented.number_of_vertices();
+        std::vector<size_t> offsets(n + 1, 0);
+        for (size_t v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + augmented[v].size();
+        }
+        std::vector<std::pair<size_t, size_t>> edges(offsets[n]);       // (target, weight), sorted in every row
+        for (size_t v = 0; v < n; ++v) {
+            for (size_t i = 0, end_ = augmented[v].size(); i < end_; ++i) {
+                edges[offsets[v] + i] = {graph::target_of(augmented[v][i]), graph::weight_of(augmented[v][i])};
+            }
+            std::sort(edges.begin() + static_cast<std::ptrdiff_t>(offsets[v]),
+                      edges.begin() + static_cast<std::ptrdiff_t>(offsets[v + 1]));
+        }
+        std::vector<size_t> taken(offsets[n], 0);       // at the first slot of every run of one target
+
+        Route result{{}, 0, transport.cost()};
+        result.tour.reserve(vertices.size());
+        result.tour.push_back({vertices[0], 0});
+        for (size_t i = 1; i < vertices.size(); ++i) {
+            size_t from = vertices[i - 1], to = vertices[i];
+            auto run = std::lower_bound(edges.begin() + static_cast<std::ptrdiff_t>(offsets[from]),
+                                        edges.begin() + static_cast<std::ptrdiff_t>(offsets[from + 1]),
+                                        std::make_pair(to, size_t(0))) - edges.begin();
+            size_t weight = edges[static_cast<size_t>(run) + taken[static_cast<size_t>(run)]++].second;
+            result.tour.push_back({to, weight});
+            result.cost += weight;
+        }
+        return result;
+    }
+
+    template<typename N>
+    graph::DirectedGraph<N> random_connected_graph(size_t number_of_vertices, size_t number_of_edges,
+                                                   uint64_t seed, size_t max_weight = 99) {
+        /**
+        *  @brief A cycle through all vertices in random order, plus uniformly random distinct edges without
+        *  self-loops up to number_of_edges, weights 1 .. max_weight. Strongly connected, and random enough for
+        *  benchmarks, as the generator of main.py.
+        */
+        if (number_of_edges <= number_of_vertices) {
+            throw std::invalid_argument("number of edges must exceed the number of vertices");
+        }
+
+        graph::DirectedGraph<N> result(number_of_vertices, true);
+        std::vector<size_t> order(number_of_vertices);
+        std::iota(order.begin(), order.end(), 0);
+        std::mt19937_64 gen(seed);
+        std::shuffle(order.begin(), order.end(), gen);
+        std::uniform_int_distribution<size_t> weight(1, max_weight);
+        for (size_t i = 0; i < number_of_vertices; ++i) {
+            result.add_edge(order[i], graph::make_edge<N>(order[(i + 1) % number_of_vertices], weight(gen)));
+        }
+
+        graph::generators::gnm(number_of_vertices, number_of_edges - number_of_vertices, true, seed, max_weight,
+                               [&result](size_t from, size_t to, size_t w) {
+                                   result.add_edge(from, graph::make_edge<N>(to, w));
+                               });
+        return result;
+    }
+}
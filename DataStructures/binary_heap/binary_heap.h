@@ -1,6 +1,8 @@
 #pragma once
 
+#include <limits>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 
@@ -125,7 +127,7 @@ namespace BinaryHeap {
         }
 
         K position_key = nodes[iter].get_key();
-        while (iter >= 0 && nodes[(iter - 1) / 2].get_key() > position_key) {
+        while (iter > 0 && nodes[(iter - 1) / 2].get_key() > position_key) {
             nodes[iter].swap(nodes[(iter - 1) / 2]);
             iter = (iter - 1) / 2;
         }
@@ -203,7 +205,167 @@ namespace BinaryHeap {
         if (iter >= nodes.size()) {
             throw std::logic_error("decrease_key overflow");
         }
-        if (new_key > nodes[iter]) {
+        if (new_key > nodes[iter].get_key()) {
+            throw std::logic_error("new key in decrease_key exceeds the existing key");
+        }
+
+        nodes[iter].set_key(new_key);
+        return sift_up(iter);
+    }
+
+
+    template<typename K>
+    class IndexedBinaryHeap final {
+        /**
+        *  @brief Binary heap over the values 0..capacity-1 that remembers where every value sits,
+        *  so a key can be decreased in place given just the value.
+        */
+        std::vector<Node<K, size_t>> nodes;
+        std::vector<BinaryHeapIterator> positions;      // npos for values not in the heap
+
+        BinaryHeapIterator sift_up(BinaryHeapIterator iter);
+
+        BinaryHeapIterator sift_down(BinaryHeapIterator iter);
+
+    public:
+        static constexpr BinaryHeapIterator npos = std::numeric_limits<BinaryHeapIterator>::max();
+
+        IndexedBinaryHeap() = default;
+
+        explicit IndexedBinaryHeap(size_t capacity) : positions(capacity, npos) {};
+
+        void resize(size_t capacity) {
+            clear();
+            positions.assign(capacity, npos);
+        };
+
+        void clear() {
+            for (const auto &it : nodes) {
+                positions[it.get_value()] = npos;
+            }
+            nodes.clear();
+        };
+
+        [[nodiscard]] size_t size() const {
+            return nodes.size();
+        };
+
+        [[nodiscard]] bool empty() const {
+            return nodes.empty();
+        };
+
+        [[nodiscard]] size_t capacity() const {
+            return positions.size();
+        };
+
+        [[nodiscard]] bool contains(size_t value) const {
+            return positions[value] != npos;
+        };
+
+        [[nodiscard]] BinaryHeapIterator position(size_t value) const {
+            return positions[value];
+        };
+
+        BinaryHeapIterator insert(const K &key, size_t value);
+
+        Node<K, size_t> extract_min();
+
+        Node<K, size_t> get_min() const;
+
+        BinaryHeapIterator decrease_key(BinaryHeapIterator iter, K new_key);
+
+        BinaryHeapIterator insert_or_decrease(const K &key, size_t value) {
+            if (positions[value] == npos) {
+                return insert(key, value);
+            }
+            return decrease_key(positions[value], key);
+        };
+    };
+
+    template<typename K>
+    BinaryHeapIterator IndexedBinaryHeap<K>::sift_up(BinaryHeapIterator iter) {
+        /**
+        *  @brief Moves a hole instead of swapping: each step copies one parent down.
+        */
+        auto node = std::move(nodes[iter]);
+        while (iter > 0 && node.get_key() < nodes[(iter - 1) / 2].get_key()) {
+            nodes[iter] = std::move(nodes[(iter - 1) / 2]);
+            positions[nodes[iter].get_value()] = iter;
+            iter = (iter - 1) / 2;
+        }
+
+        positions[node.get_value()] = iter;
+        nodes[iter] = std::move(node);
+        return iter;
+    }
+
+    template<typename K>
+    BinaryHeapIterator IndexedBinaryHeap<K>::sift_down(BinaryHeapIterator iter) {
+        auto node = std::move(nodes[iter]);
+        for (BinaryHeapIterator child = 2 * iter + 1, end_ = nodes.size(); child < end_; child = 2 * iter + 1) {
+            if (child + 1 < end_ && nodes[child + 1].get_key() < nodes[child].get_key()) {
+                ++child;
+            }
+            if (!(nodes[child].get_key() < node.get_key())) {
+                break;
+            }
+
+            nodes[iter] = std::move(nodes[child]);
+            positions[nodes[iter].get_value()] = iter;
+            iter = child;
+        }
+
+        positions[node.get_value()] = iter;
+        nodes[iter] = std::move(node);
+        return iter;
+    }
+
+    template<typename K>
+    BinaryHeapIterator IndexedBinaryHeap<K>::insert(const K &key, size_t value) {
+        if (value >= positions.size()) {
+            throw std::logic_error("value exceeds the heap capacity");
+        }
+        if (positions[value] != npos) {
+            throw std::logic_error("value is already in the heap");
+        }
+
+        positions[value] = nodes.size();
+        nodes.push_back(Node<K, size_t>(key, value));
+        return sift_up(nodes.size() - 1);
+    }
+
+    template<typename K>
+    Node<K, size_t> IndexedBinaryHeap<K>::get_min() const {
+        if (nodes.empty()) {
+            throw std::logic_error("get_min underflow");
+        }
+        return nodes[0];
+    }
+
+    template<typename K>
+    Node<K, size_t> IndexedBinaryHeap<K>::extract_min() {
+        if (nodes.empty()) {
+            throw std::logic_error("extract_min underflow");
+        }
+
+        auto result = std::move(nodes[0]);
+        positions[result.get_value()] = npos;
+        if (nodes.size() > 1) {
+            nodes[0] = std::move(nodes.back());
+            nodes.pop_back();
+            sift_down(0);
+        } else {
+            nodes.pop_back();
+        }
+        return result;
+    }
+
+    template<typename K>
+    BinaryHeapIterator IndexedBinaryHeap<K>::decrease_key(BinaryHeapIterator iter, K new_key) {
+        if (iter >= nodes.size()) {
+            throw std::logic_error("decrease_key overflow");
+        }
+        if (nodes[iter].get_key() < new_key) {
             throw std::logic_error("new key in decrease_key exceeds the existing key");
         }
 
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../binary_heap/binary_heap.h"
+
+
+namespace BucketQueue {
+    using BucketQueueIterator = size_t;
+
+    template<typename K>
+    class BucketQueue final {
+        /**
+        *  @brief Dial's bucket queue over the values 0..capacity-1: a circular array of span + 1 buckets, one per
+        *  key in [last, last + span], where last is the last extracted key. Every operation is O(1) apart from
+        *  extraction walking over empty buckets, so it pays off for small spans, e.g. Dijkstra with span equal
+        *  to the largest edge weight. Same interface as BinaryHeap::IndexedBinaryHeap; handles are the values.
+        *  Spans above MAX_SPAN are rejected: the buckets are allocated up front, so a large span costs memory in
+        *  proportion and is better served by a radix or binary heap.
+        */
+        static_assert(std::is_unsigned<K>::value, "bucket queue keys must be unsigned integers");
+
+        std::vector<std::vector<size_t>> buckets;
+        std::vector<K> keys;
+        std::vector<size_t> slots;      // index inside the bucket, npos for values not in the queue
+        K last;
+        size_t cursor;
+        size_t count;
+
+        size_t bucket_for(K key) const {
+            return static_cast<size_t>(key % buckets.size());
+        };
+
+        void unlink(size_t value) {
+            auto &bucket = buckets[bucket_for(keys[value])];
+            size_t slot = slots[value];
+            bucket[slot] = bucket.back();
+            slots[bucket[slot]] = slot;
+            bucket.pop_back();
+        };
+
+        static size_t checked_span(K span) {
+            if (span > MAX_SPAN) {
+                throw std::invalid_argument("bucket queue span");
+            }
+            return static_cast<size_t>(span);
+        };
+
+        void check_window(K key) const {
+            if (key < last || key - last >= buckets.size()) {
+                throw std::logic_error("key outside the bucket window");
+            }
+        };
+
+    public:
+        static constexpr BucketQueueIterator npos = std::numeric_limits<BucketQueueIterator>::max();
+
+        static constexpr size_t MAX_SPAN = (size_t(1) << 20u) - 1;
+
+        BucketQueue() : BucketQueue(0, 0) {};
+
+        BucketQueue(size_t capacity, K span) : buckets(checked_span(span) + 1), keys(capacity),
+                                               slots(capacity, npos), last(0), cursor(0), count(0) {};
+
+        void resize(size_t capacity) {
+            clear();
+            keys.assign(capacity, K());
+            slots.assign(capacity, npos);
+        };
+
+        void clear() {
+            for (auto &bucket : buckets) {
+                for (const auto &it : bucket) {
+                    slots[it] = npos;
+                }
+                bucket.clear();
+            }
+            last = 0;
+            cursor = 0;
+            count = 0;
+        };
+
+        [[nodiscard]] size_t size() const {
+            return count;
+        };
+
+        [[nodiscard]] bool empty() const {
+            return count == 0;
+        };
+
+        [[nodiscard]] size_t capacity() const {
+            return slots.size();
+        };
+
+        [[nodiscard]] K span() const {
+            return static_cast<K>(buckets.size() - 1);
+        };
+
+        [[nodiscard]] bool contains(size_t value) const {
+            return slots[value] != npos;
+        };
+
+        [[nodiscard]] BucketQueueIterator position(size_t value) const {
+            return slots[value] != npos ? value : npos;
+        };
+
+        BucketQueueIterator insert(const K &key, size_t value);
+
+        BinaryHeap::Node<K, size_t> extract_min();
+
+        BinaryHeap::Node<K, size_t> get_min();
+
+        BucketQueueIterator decrease_key(BucketQueueIterator iter, K new_key);
+
+        BucketQueueIterator insert_or_decrease(const K &key, size_t value) {
+            if (slots[value] == npos) {
+                return insert(key, value);
+            }
+            return decrease_key(value, key);
+        };
+    };
+
+    template<typename K>
+    BucketQueueIterator BucketQueue<K>::insert(const K &key, size_t value) {
+        if (value >= slots.size()) {
+            throw std::logic_error("value exceeds the queue capacity");
+        }
+        if (slots[value] != npos) {
+            throw std::logic_error("value is already in the queue");
+        }
+        check_window(key);
+
+        keys[value] = key;
+        auto &bucket = buckets[bucket_for(key)];
+        slots[value] = bucket.size();
+        bucket.push_back(value);
+        ++count;
+        return value;
+    }
+
+    template<typename K>
+    BinaryHeap::Node<K, size_t> BucketQueue<K>::get_min() {
+        /**
+        *  @brief Not const: advances the cursor past empty buckets.
+        */
+        if (count == 0) {
+            throw std::logic_error("get_min underflow");
+        }
+
+        while (buckets[cursor].empty()) {
+            cursor = cursor + 1 == buckets.size() ? 0 : cursor + 1;
+        }
+
+        size_t value = buckets[cursor].back();
+        return BinaryHeap::Node<K, size_t>(keys[value], value);
+    }
+
+    template<typename K>
+    BinaryHeap::Node<K, size_t> BucketQueue<K>::extract_min() {
+        if (count == 0) {
+            throw std::logic_error("extract_min underflow");
+        }
+
+        auto result = get_min();
+        buckets[cursor].pop_back();
+        slots[result.get_value()] = npos;
+        last = result.get_key();
+        --count;
+        return result;
+    }
+
+    template<typename K>
+    BucketQueueIterator BucketQueue<K>::decrease_key(BucketQueueIterator iter, K new_key) {
+        if (iter >= slots.size() || slots[iter] == npos) {
+            throw std::logic_error("decrease_key overflow");
+        }
+        if (keys[iter] < new_key) {
+            throw std::logic_error("new key in decrease_key exceeds the existing key");
+        }
+        check_window(new_key);
+
+        unlink(iter);
+        keys[iter] = new_key;
+        auto &bucket = buckets[bucket_for(new_key)];
+        slots[iter] = bucket.size();
+        bucket.push_back(iter);
+        return iter;
+    }
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "graph.h"
+
+
+namespace graph {
+    template<typename T>
+    class AdjacencyRange final {
+        T *first;
+        T *last;
+
+    public:
+        AdjacencyRange() : first(nullptr), last(nullptr) {};
+
+        AdjacencyRange(T *new_first, T *new_last) : first(new_first), last(new_last) {};
+
+        T *begin() const {
+            return first;
+        };
+
+        T *end() const {
+            return last;
+        };
+
+        [[nodiscard]] size_t size() const {
+            return static_cast<size_t>(last - first);
+        };
+
+        [[nodiscard]] bool empty() const {
+            return first == last;
+        };
+
+        T &operator [](const size_t &index) const {
+            return first[index];
+        };
+    };
+
+
+    template<typename N>
+    class CSRGraph final {
+        size_t edges;
+        bool weighted;
+        bool directed;
+        std::vector<size_t> offsets;        // offsets[v]..offsets[v + 1] is the slice of targets owned by v
+        std::vector<N> targets;
+        std::vector<size_t> in_degrees;     // kept for directed graphs only, undirected ones have in == out
+
+        template<typename G>
+        void build(const G &g);
+
+    public:
+        class RowIterator final {
+            const CSRGraph<N> *owner;
+            size_t index;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = AdjacencyRange<const N>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = AdjacencyRange<const N>;
+
+            RowIterator(const CSRGraph<N> *new_owner, size_t new_index) : owner(new_owner), index(new_index) {};
+
+            AdjacencyRange<const N> operator *() const {
+                return (*owner)[index];
+            };
+
+            RowIterator &operator ++() {
+                ++index;
+                return *this;
+            };
+
+            RowIterator operator ++(int) {
+                RowIterator result(*this);
+                ++index;
+                return result;
+            };
+
+            bool operator ==(const RowIterator &other) const {
+                return index == other.index && owner == other.owner;
+            };
+
+            bool operator !=(const RowIterator &other) const {
+                return !(*this == other);
+            };
+        };
+
+        using node_type = N;
+
+        CSRGraph() : edges(0), weighted(false), directed(true), offsets(1, 0) {};
+
+        explicit CSRGraph(const DirectedGraph<N> &g);
+
+        explicit CSRGraph(const UndirectedGraph<N> &g);
+
+        [[nodiscard]] size_t number_of_vertices() const {
+            return offsets.size() - 1;
+        };
+
+        [[nodiscard]] size_t number_of_edges() const {
+            return edges;
+        };
+
+        [[nodiscard]] bool empty() const {
+            return offsets.size() == 1;
+        };
+
+        [[nodiscard]] bool is_weighted() const {
+            return weighted;
+        };
+
+        [[nodiscard]] bool is_directed() const {
+            return directed;
+        };
+
+        [[nodiscard]] size_t degree(const size_t &index) const {
+            return offsets[index + 1] - offsets[index];
+        };
+
+        [[nodiscard]] size_t in_degree(const size_t &index) const {
+            return directed ? in_degrees[index] : degree(index);
+        };
+
+        [[nodiscard]] const std::vector<size_t> &get_offsets() const {
+            return offsets;
+        };
+
+        [[nodiscard]] const std::vector<N> &get_targets() const {
+            return targets;
+        };
+
+        [[nodiscard]] CSRGraph<N> transposed() const;
+
+        [[nodiscard]] RowIterator begin() const {
+            return RowIterator(this, 0);
+        };
+
+        [[nodiscard]] RowIterator end() const {
+            return RowIterator(this, number_of_vertices());
+        };
+
+        AdjacencyRange<const N> operator [](const size_t &index) const {
+            const N *base = targets.data();
+            return AdjacencyRange<const N>(base + offsets[index], base + offsets[index + 1]);
+        };
+    };
+
+    template<typename N>
+    template<typename G>
+    void CSRGraph<N>::build(const G &g) {
+        size_t total = 0;
+        for (const auto &it : g) {
+            total += it.size();
+        }
+
+        offsets.reserve(g.number_of_vertices() + 1);
+        targets.reserve(total);
+        for (const auto &it : g) {
+            targets.insert(targets.end(), it.begin(), it.end());
+            offsets.push_back(targets.size());
+        }
+    }
+
+    template<typename N>
+    CSRGraph<N>::CSRGraph(const DirectedGraph<N> &g) : edges(g.number_of_edges()), weighted(g.is_weighted()),
+                                                       directed(true), offsets(1, 0),
+                                                       in_degrees(g.number_of_vertices(), 0) {
+        build(g);
+
+        for (const auto &it : targets) {
+            ++in_degrees[static_cast<size_t>(it)];
+        }
+    }
+
+    template<typename N>
+    CSRGraph<N>::CSRGraph(const UndirectedGraph<N> &g) : edges(g.number_of_edges()), weighted(g.is_weighted()),
+                                                         directed(false), offsets(1, 0) {
+        build(g);
+    }
+
+    template<typename N>
+    CSRGraph<N> CSRGraph<N>::transposed() const {
+        /**
+        *  @brief The same graph with every edge reversed, weights kept: row v lists the edges entering v.
+        */
+        if (!directed) {
+            return *this;
+        }
+
+        size_t n = number_of_vertices();
+        CSRGraph<N> result;
+        result.edges = edges;
+        result.weighted = weighted;
+        result.offsets.assign(n + 1, 0);
+        result.in_degrees.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.offsets[i + 1] = result.offsets[i] + in_degrees[i];
+            result.in_degrees[i] = degree(i);
+        }
+
+        std::vector<size_t> fill(result.offsets.begin(), result.offsets.end() - 1);
+        result.targets.resize(targets.size());
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto &it : (*this)[i]) {
+                result.targets[fill[static_cast<size_t>(it)]++] = with_target(it, i);
+            }
+        }
+        return result;
+    }
+
+    template<typename N>
+    CSRGraph<N> transpose(const DirectedGraph<N> &g) {
+        return CSRGraph<N>(g).transposed();
+    }
+
+    template<typename N>
+    CSRGraph<N> transpose(const UndirectedGraph<N> &g) {
+        return CSRGraph<N>(g);
+    }
+
+    template<typename N>
+    CSRGraph<N> transpose(const CSRGraph<N> &g) {
+        return g.transposed();
+    }
+
+    template<typename N>
+    CSRGraph<N> to_csr(const DirectedGraph<N> &g) {
+        return CSRGraph<N>(g);
+    }
+
+    template<typename N>
+    CSRGraph<N> to_csr(const UndirectedGraph<N> &g) {
+        return CSRGraph<N>(g);
+    }
+
+    template<typename N>
+    std::ostream &operator<<(std::ostream &os, const CSRGraph<N> &g) {
+        for (size_t i = 0, end_ = g.number_of_vertices(); i < end_; ++i) {
+            if (i) {
+                os << '\n';
+            }
+            os << i << ": ";
+            for (const auto &it : g[i]) {
+                os << it << " ";
+            }
+        }
+        return os;
+    }
+}
@@ -4,60 +4,64 @@
 #include <cstdint>
 #include <iostream>
 #include <random>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-
-namespace graph {
-    static size_t generate_optimal_number(const size_t &number_of_vertices, const size_t &number_of_edges) {
-        size_t tmp = number_of_edges / number_of_vertices;
-        if (tmp + 2 < number_of_vertices) {
-            return tmp + 2;
-        }
-        else {
-            return number_of_vertices / 2;
-        }
-    }
+#include "graph_generators.h"
 
 
-    struct Node final {
-        size_t number;
-        size_t weight;
+namespace graph {
+    template<typename I, typename W>
+    struct BasicNode final {
+        I number;
+        W weight;
 
-        Node() : number(0), weight(0) {};
+        BasicNode() : number(0), weight(0) {};
 
-        explicit Node(const size_t &new_number) : number(new_number), weight(1) {};
+        explicit BasicNode(const I &new_number) : number(new_number), weight(1) {};
 
-        Node(const size_t &new_number, const size_t &new_weight) : number(new_number), weight(new_weight) {};
+        BasicNode(const I &new_number, const W &new_weight) : number(new_number), weight(new_weight) {};
 
-        Node &operator=(const size_t &new_number) {
+        BasicNode &operator=(const I &new_number) {
             weight = 1;
             number = new_number;
             return *this;
         }
 
-        explicit operator const size_t &() const {
+        explicit operator size_t() const {
             return number;
         };
     };
 
-    bool operator>=(const Node &lhs, const size_t &rhs) {
+    using Node = BasicNode<size_t, size_t>;
+    using CompactNode = BasicNode<uint32_t, uint32_t>;      // 8 bytes per weighted edge, graphs below 2^32 vertices
+
+    template<typename I, typename W>
+    bool operator>=(const BasicNode<I, W> &lhs, const size_t &rhs) {
         return lhs.number >= rhs;
     }
 
-    bool operator==(const size_t &lhs, const Node &rhs) {
+    template<typename I, typename W>
+    bool operator==(const size_t &lhs, const BasicNode<I, W> &rhs) {
         return lhs == rhs.number;
     }
 
-    bool operator==(const Node &lhs, const size_t &rhs) {
+    template<typename I, typename W>
+    bool operator==(const BasicNode<I, W> &lhs, const size_t &rhs) {
         return lhs.number == rhs;
     }
 
-    bool operator==(const Node &lhs, const Node &rhs) {
+    template<typename I, typename W>
+    bool operator==(const BasicNode<I, W> &lhs, const BasicNode<I, W> &rhs) {
         return lhs.number == rhs.number && lhs.weight == rhs.weight;
     }
 
-    std::ostream &operator<<(std::ostream &os, const Node &node) {
+    template<typename I, typename W>
+    std::ostream &operator<<(std::ostream &os, const BasicNode<I, W> &node) {
         os << "(" << node.number << ", " << node.weight << ")";
 
         return os;
@@ -65,7 +69,146 @@ namespace graph {
 
 
     template<typename N>
-    class Graph {
+    struct edge_traits {        // plain vertex ids: unweighted edges of sizeof(N) bytes
+        static_assert(std::is_integral<N>::value, "node type must be an integer id or a BasicNode");
+
+        using index_type = N;
+        using weight_type = size_t;
+        static constexpr bool weighted = false;
+
+        static size_t target(const N &node) {
+            return static_cast<size_t>(node);
+        };
+
+        static size_t weight(const N &) {
+            return 1;
+        };
+
+        static N make(size_t target, size_t) {
+            return static_cast<N>(target);
+        };
+    };
+
+    template<typename I, typename W>
+    struct edge_traits<BasicNode<I, W>> {
+        using index_type = I;
+        using weight_type = W;
+        static constexpr bool weighted = true;
+
+        static size_t target(const BasicNode<I, W> &node) {
+            return node.number;
+        };
+
+        static size_t weight(const BasicNode<I, W> &node) {
+            return node.weight;
+        };
+
+        static BasicNode<I, W> make(size_t target, size_t weight) {
+            return BasicNode<I, W>(static_cast<I>(target), static_cast<W>(weight));
+        };
+    };
+
+    template<typename N>
+    N with_target(const N &node, size_t target) {        // the same edge led to another vertex
+        return edge_traits<N>::make(target, edge_traits<N>::weight(node));
+    }
+
+    template<typename N>
+    size_t weight_of(const N &node) {
+        return edge_traits<N>::weight(node);
+    }
+
+    template<typename N>
+    N make_edge(size_t target, size_t weight) {         // unweighted node types drop the weight
+        return edge_traits<N>::make(target, weight);
+    }
+
+    inline void check_permutation(const std::vector<size_t> &new_ids, size_t size) {
+        if (new_ids.size() != size) {
+            throw std::invalid_argument("permutation size");
+        }
+
+        std::vector<bool> seen(size, false);
+        for (const auto &it : new_ids) {
+            if (it >= size || seen[it]) {
+                throw std::invalid_argument("not a permutation");
+            }
+            seen[it] = true;
+        }
+    }
+
+
+    class EdgeIndex final {
+        /**
+        *  @brief Hash index from (source, target) to the positions of such edges in the source's adjacency vector.
+        *  Parallel edges share a key, the caller tells them apart by looking at the adjacency entries.
+        */
+        struct KeyHash final {
+            size_t operator()(const std::pair<size_t, size_t> &key) const {
+                return generators::detail::mix(key.first, key.second);
+            };
+        };
+
+        std::unordered_multimap<std::pair<size_t, size_t>, size_t, KeyHash> positions;
+
+    public:
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        void clear() {
+            positions.clear();
+        };
+
+        void reserve(size_t count) {
+            positions.reserve(count);
+        };
+
+        [[nodiscard]] size_t size() const {
+            return positions.size();
+        };
+
+        [[nodiscard]] bool contains(size_t source, size_t target) const {
+            return positions.find({source, target}) != positions.end();
+        };
+
+        void insert(size_t source, size_t target, size_t position) {
+            positions.emplace(std::make_pair(source, target), position);
+        };
+
+        template<typename F>
+        size_t find_if(size_t source, size_t target, F &&match) const {
+            auto range = positions.equal_range({source, target});
+            for (auto it = range.first; it != range.second; ++it) {
+                if (match(it->second)) {
+                    return it->second;
+                }
+            }
+            return npos;
+        };
+
+        void erase(size_t source, size_t target, size_t position) {
+            auto range = positions.equal_range({source, target});
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == position) {
+                    positions.erase(it);
+                    return;
+                }
+            }
+        };
+
+        void move(size_t source, size_t target, size_t from, size_t to) {
+            auto range = positions.equal_range({source, target});
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == from) {
+                    it->second = to;
+                    return;
+                }
+            }
+        };
+    };
+
+
+    template<typename N>
+    class Graph {       // type-erased interface, see GraphAdapter
     public:
         void reserve(size_t cap) {
             do_reserve(cap);
@@ -120,51 +263,136 @@ namespace graph {
     };
 
 
+    template<typename Derived, typename N>
+    class GraphBase {
+        /**
+        *  @brief Static-polymorphism counterpart of Graph: the same public interface resolved at compile time,
+        *  the concrete graph provides the private do_* / get_* hooks and befriends this class.
+        */
+        Derived &derived() {
+            return static_cast<Derived &>(*this);
+        };
+
+        const Derived &derived() const {
+            return static_cast<const Derived &>(*this);
+        };
+
+    public:
+        void reserve(size_t cap) {
+            derived().do_reserve(cap);
+        };
+
+        size_t number_of_vertices() const {
+            return derived().get_number_of_vertices();
+        };
+
+        size_t number_of_edges() const {
+            return derived().get_number_of_edges();
+        };
+
+        bool empty() const {
+            return derived().is_empty();
+        };
+
+        bool is_weighted() const {
+            return derived().check_if_weighted();
+        };
+
+        void add_node(size_t number, N *begin, size_t sz) {
+            derived().do_add_node(number, begin, sz);
+        };
+
+        void remove_edge(size_t first, const N &last) {
+            derived().do_remove_edge(first, last);
+        };
+
+        void remove_edge(size_t first) {
+            derived().do_remove_edge(first);
+        };
+
+    protected:
+        GraphBase() = default;
+
+        ~GraphBase() noexcept = default;
+    };
+
+
     template<typename N>
-    class DirectedGraph final : public Graph<N> {
+    class DirectedGraph final : public GraphBase<DirectedGraph<N>, N> {
+        friend class GraphBase<DirectedGraph<N>, N>;
+
         size_t edges;
         bool weighted;
         std::vector<std::vector<N>> adj_list;
         std::vector<size_t> in_degrees;
+        bool indexed;
+        EdgeIndex edge_index;
 
-        void do_reserve(size_t cap) override {
+        void do_reserve(size_t cap) {
             adj_list.reserve(cap);
             in_degrees.reserve(cap);
         };
 
-        size_t get_number_of_vertices() const override {
+        size_t get_number_of_vertices() const {
             return adj_list.size();
         };
 
-        size_t get_number_of_edges() const override {
+        size_t get_number_of_edges() const {
             return edges;
         };
 
-        bool is_empty() const override {
+        bool is_empty() const {
             return adj_list.empty();
         };
 
-        bool check_if_weighted() const override {
-            return weighted;
+        bool check_if_weighted() const {
+            return weighted_edges && weighted;
         }
 
-        void do_add_node(size_t number, N *begin, size_t sz) override;
+        void do_add_node(size_t number, N *begin, size_t sz);
+
+        void do_remove_edge(size_t first, const N &last);
+
+        void do_remove_edge(size_t first);
+
+        void push_edge(size_t first, const N &last) {
+            if (indexed) {
+                edge_index.insert(first, static_cast<size_t>(last), adj_list[first].size());
+            }
+            adj_list[first].push_back(last);
+        };
 
-        void do_remove_edge(size_t first, const N &last) override;
+        size_t find_edge(size_t first, const N &last) const;
 
-        void do_remove_edge(size_t first) override;
+        void pop_edge(size_t first, size_t position);
 
     public:
-        DirectedGraph() : Graph<N>(), edges(0), weighted(false) {};
+        using node_type = N;
+        using index_type = typename edge_traits<N>::index_type;
+
+        static constexpr bool weighted_edges = edge_traits<N>::weighted;
 
-        DirectedGraph(size_t sz, bool w) : Graph<N>(), edges(0), weighted(w), adj_list(sz), in_degrees(sz, 0) {};
+        using GraphBase<DirectedGraph<N>, N>::add_node;
+
+        DirectedGraph() : edges(0), weighted(weighted_edges), indexed(false) {};
+
+        explicit DirectedGraph(size_t sz) : DirectedGraph(sz, weighted_edges) {};
+
+        DirectedGraph(size_t sz, bool w) : edges(0), weighted(w), adj_list(sz), in_degrees(sz, 0), indexed(false) {
+            if (sz > 0 && sz - 1 > std::numeric_limits<index_type>::max()) {
+                throw std::invalid_argument("too many vertices for the index type");
+            }
+        };
 
         DirectedGraph(const DirectedGraph &other) = default;
 
         DirectedGraph(DirectedGraph &&other) noexcept: edges(other.edges), weighted(other.weighted),
                                                        adj_list(std::move(other.adj_list)),
-                                                       in_degrees(std::move(other.in_degrees)) {
+                                                       in_degrees(std::move(other.in_degrees)),
+                                                       indexed(other.indexed),
+                                                       edge_index(std::move(other.edge_index)) {
             other.edges = 0;
+            other.indexed = false;
         };
 
         DirectedGraph &operator=(const DirectedGraph<N> &other) = default;
@@ -178,20 +406,51 @@ namespace graph {
             weighted = other.weighted;
             adj_list = std::move(other.adj_list);
             in_degrees = std::move(other.in_degrees);
+            indexed = other.indexed;
+            edge_index = std::move(other.edge_index);
 
             other.edges = 0;
+            other.indexed = false;
             return *this;
         };
 
-        ~DirectedGraph() override = default;
+        ~DirectedGraph() = default;
 
         template<typename INIt>
         void add_node(size_t number, INIt begin, INIt end);
 
+        void add_edge(size_t first, const N &last);
+
+        template<typename INIt>
+        void add_edges(INIt begin, INIt end);
+
+        template<typename INIt>
+        void remove_edges(INIt begin, INIt end);
+
+        [[nodiscard]] bool has_edge(size_t first, size_t last) const;
+
+        void build_edge_index();
+
+        void relabel(const std::vector<size_t> &new_ids);
+
+        void drop_edge_index() {
+            indexed = false;
+            edge_index.clear();
+        };
+
+        [[nodiscard]] bool has_edge_index() const {
+            return indexed;
+        };
+
+        [[nodiscard]] size_t in_degree(const size_t &index) const {
+            return in_degrees[index];
+        };
+
         template<typename T>
         friend std::ostream &operator<<(std::ostream &os, const DirectedGraph<T> &g);
 
-        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0);
+        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0,
+                                   uint64_t seed = std::random_device()());
 
         auto begin() {
             return adj_list.begin();
@@ -225,7 +484,7 @@ namespace graph {
             for (const auto &it : g.adj_list[i]) {
                 os << it << " ";
             }
-            os << std::endl;
+            os << '\n';
         }
         os << g.number_of_vertices() - 1 << ": ";
         for (const auto &it : g.adj_list[g.number_of_vertices() - 1]) {
@@ -242,64 +501,161 @@ namespace graph {
         if (sz < 1) {
             throw std::invalid_argument("range");
         }
-        if (sz == 1) {
-            return;
-        }
 
-        if (number < Graph<N>::number_of_vertices()) {
-            in_degrees[number] += sz;
-
-            auto &iter = adj_list[number];
+        if (number < this->number_of_vertices()) {
             for (auto &it = begin; it != end; it = std::next(it)) {
                 ++in_degrees[static_cast<size_t>(*it)];
-                iter.push_back(*it);
+                push_edge(number, *it);
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_vertices()) {
-            std::vector<N> tmp;
-            tmp.reserve(sz);
+        } else if (number == this->number_of_vertices()) {
+            in_degrees.push_back(0);
+            adj_list.emplace_back();
+            adj_list.back().reserve(sz);
 
             for (auto &it = begin; it != end; it = std::next(it)) {
                 ++in_degrees[static_cast<size_t>(*it)];
-                tmp.push_back(*it);
+                push_edge(number, *it);
             }
 
-            in_degrees.push_back(sz);
-            adj_list.emplace_back(std::move(tmp));
             edges += sz;
         } else {
             throw std::invalid_argument("vertex to add");
         }
     }
 
+    template<typename N>
+    void DirectedGraph<N>::add_edge(size_t first, const N &last) {
+        if (first >= this->number_of_vertices() ||
+            last >= this->number_of_vertices()) {
+            throw std::invalid_argument("invalid vertices");
+        }
+
+        push_edge(first, last);
+        ++in_degrees[static_cast<size_t>(last)];
+        ++edges;
+    }
+
+    template<typename N>
+    template<typename INIt>
+    void DirectedGraph<N>::add_edges(INIt begin, INIt end) {
+        /**
+        *  @brief Appends a batch of (source, node) pairs; the whole batch is validated before anything changes.
+        */
+        size_t count = 0;
+        for (auto it = begin; it != end; ++it, ++count) {
+            if (it->first >= this->number_of_vertices() || it->second >= this->number_of_vertices()) {
+                throw std::invalid_argument("invalid vertices");
+            }
+        }
+
+        if (indexed) {
+            edge_index.reserve(edge_index.size() + count);
+        }
+        for (auto it = begin; it != end; ++it) {
+            push_edge(it->first, it->second);
+            ++in_degrees[static_cast<size_t>(it->second)];
+        }
+        edges += count;
+    }
+
+    template<typename N>
+    template<typename INIt>
+    void DirectedGraph<N>::remove_edges(INIt begin, INIt end) {
+        for (auto it = begin; it != end; ++it) {
+            do_remove_edge(it->first, it->second);
+        }
+    }
+
+    template<typename N>
+    bool DirectedGraph<N>::has_edge(size_t first, size_t last) const {
+        if (first >= this->number_of_vertices() || last >= this->number_of_vertices()) {
+            throw std::invalid_argument("invalid vertices");
+        }
+
+        if (indexed) {
+            return edge_index.contains(first, last);
+        }
+        const auto &list = adj_list[first];
+        return std::any_of(list.begin(), list.end(), [last](const N &node) {
+            return static_cast<size_t>(node) == last;
+        });
+    }
+
+    template<typename N>
+    void DirectedGraph<N>::build_edge_index() {
+        /**
+        *  @brief Switches the graph to indexed mode: has_edge and remove_edge become expected O(1)
+        *  at the cost of one hash entry per edge. Rows edited through operator[] bypass the index,
+        *  call this again after doing so.
+        */
+        edge_index.clear();
+        edge_index.reserve(edges);
+        for (size_t i = 0, end_ = adj_list.size(); i < end_; ++i) {
+            for (size_t j = 0, size_ = adj_list[i].size(); j < size_; ++j) {
+                edge_index.insert(i, static_cast<size_t>(adj_list[i][j]), j);
+            }
+        }
+        indexed = true;
+    }
+
+    template<typename N>
+    size_t DirectedGraph<N>::find_edge(size_t first, const N &last) const {
+        const auto &list = adj_list[first];
+        if (indexed) {
+            return edge_index.find_if(first, static_cast<size_t>(last), [&list, &last](size_t position) {
+                return list[position] == last;
+            });
+        }
+
+        auto node = std::find(list.begin(), list.end(), last);
+        return node == list.end() ? EdgeIndex::npos : static_cast<size_t>(node - list.begin());
+    }
+
+    template<typename N>
+    void DirectedGraph<N>::pop_edge(size_t first, size_t position) {
+        /**
+        *  @brief Swap-and-pop: the last edge of the row takes the place of the removed one.
+        */
+        auto &list = adj_list[first];
+        size_t back = list.size() - 1;
+        if (indexed) {
+            edge_index.erase(first, static_cast<size_t>(list[position]), position);
+            if (position != back) {
+                edge_index.move(first, static_cast<size_t>(list[back]), back, position);
+            }
+        }
+
+        if (position != back) {
+            list[position] = std::move(list[back]);
+        }
+        list.pop_back();
+    }
+
     template<typename N>
     void DirectedGraph<N>::do_add_node(size_t number, N *begin, size_t sz) {
         if (!begin) {
             throw std::invalid_argument("list of nodes");
         }
 
-        if (number < Graph<N>::number_of_vertices()) {
-            in_degrees[number] += sz;
-
-            auto &iter = adj_list[number];
+        if (number < this->number_of_vertices()) {
             for (size_t i = 0; i < sz; ++i) {
                 ++in_degrees[static_cast<size_t>(*(begin + i))];
-                iter.push_back(*(begin + i));
+                push_edge(number, *(begin + i));
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_vertices()) {
-            std::vector<N> tmp;
-            tmp.reserve(sz);
+        } else if (number == this->number_of_vertices()) {
+            in_degrees.push_back(0);
+            adj_list.emplace_back();
+            adj_list.back().reserve(sz);
 
             for (size_t i = 0; i < sz; ++i) {
                 ++in_degrees[static_cast<size_t>(*(begin + i))];
-                tmp.push_back(*(begin + i));
+                push_edge(number, *(begin + i));
             }
 
-            in_degrees.push_back(sz);
-            adj_list.push_back(std::move(tmp));
             edges += sz;
         } else {
             throw std::invalid_argument("vertex to add");
@@ -308,15 +664,14 @@ namespace graph {
 
     template<typename N>
     void DirectedGraph<N>::do_remove_edge(size_t first, const N &last) {
-        if (first >= Graph<N>::number_of_vertices() ||
-            last >= Graph<N>::number_of_vertices()) {      // N type must implement comparison with size_t type
+        if (first >= this->number_of_vertices() ||
+            last >= this->number_of_vertices()) {      // N type must implement comparison with size_t type
             throw std::invalid_argument("invalid vertices");
         }
 
-        auto &list = adj_list[first];
-        auto node = std::find(list.begin(), list.end(), last);
-        if (node != list.end()) {
-            list.erase(node);
+        size_t position = find_edge(first, last);
+        if (position != EdgeIndex::npos) {
+            pop_edge(first, position);
             --in_degrees[static_cast<size_t>(last)];
             --edges;
         }
@@ -324,199 +679,141 @@ namespace graph {
 
     template<typename N>
     void DirectedGraph<N>::do_remove_edge(size_t first) {
-        if (first >= Graph<N>::number_of_vertices()) {
+        if (first >= this->number_of_vertices()) {
             throw std::invalid_argument("invalid vertex");
         }
 
-        for (const auto &it : adj_list[first]) {
-            --in_degrees[static_cast<size_t>(it)];
+        auto &list = adj_list[first];
+        for (size_t i = 0, end_ = list.size(); i < end_; ++i) {
+            --in_degrees[static_cast<size_t>(list[i])];
+            if (indexed) {
+                edge_index.erase(first, static_cast<size_t>(list[i]), i);
+            }
         }
 
-        auto &list = adj_list[first];
         edges -= list.size();
         list.clear();
     }
 
     template<typename N>
-    void DirectedGraph<N>::generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight) {
-        if (static_cast<uint64_t>(number_of_edges) >
-            static_cast<uint64_t>(number_of_vertices) * (number_of_vertices - 1)) {
-            throw std::invalid_argument("cannot create graph with such number of edges");
-        }
-
-        if (max_weight) {
-            DirectedGraph<N> result(number_of_vertices, true);
-
-            size_t already_generated = 0;
-            size_t opt_number = generate_optimal_number(number_of_vertices, number_of_edges);
-
-            std::random_device rd0;
-            std::mt19937 gen0(rd0());
-            std::uniform_int_distribution<> weight_dis(1, max_weight);
-
-            std::random_device rd1;
-            std::mt19937 gen1(rd1());
-            std::uniform_int_distribution<> vert_dis(0, number_of_vertices - 1);
-
-            std::random_device rd2;
-            std::mt19937 gen2(rd2());
-            std::uniform_int_distribution<> edge_dis(1, std::min(opt_number, number_of_vertices - 1));
-
-            std::vector<bool> vertices(number_of_vertices, false);
-
-            std::vector<bool> tmp(number_of_vertices, false);
-            while (already_generated != number_of_edges) {
-                size_t current_index = vert_dis(gen1);
-                while (vertices[current_index]) {
-                    current_index = vert_dis(gen1);
-                }
-                vertices[current_index] = true;
-
-                size_t current_edges = edge_dis(gen2);
-                while (already_generated > number_of_edges - current_edges) {
-                    current_edges = edge_dis(gen2);
-                }
-                already_generated += current_edges;
-
-                size_t tmp_counter = 0;
-                std::fill(tmp.begin(), tmp.end(), false);
-                tmp[current_index] = true;
-
-                std::vector<N> tmp_res;
-                tmp_res.reserve(current_edges);
-                while (tmp_counter != current_edges) {
-                    size_t tmp_index = current_index;
-                    while (tmp[tmp_index]) {
-                        tmp_index = vert_dis(gen1);
-                    }
-
-                    ++tmp_counter;
-                    tmp[tmp_index] = true;
-
-                    ++result.in_degrees[tmp_index];
-                    tmp_res.push_back(static_cast<N>(Node(tmp_index, weight_dis(gen0))));
-                }
-
-                result.adj_list[current_index] = std::move(tmp_res);
+    void DirectedGraph<N>::relabel(const std::vector<size_t> &new_ids) {
+        /**
+        *  @brief Renames every vertex v to new_ids[v], rows and edge targets alike; new_ids must be a permutation.
+        */
+        check_permutation(new_ids, adj_list.size());
+
+        std::vector<std::vector<N>> rows(adj_list.size());
+        std::vector<size_t> degrees(in_degrees.size());
+        for (size_t i = 0, end_ = adj_list.size(); i < end_; ++i) {
+            for (auto &it : adj_list[i]) {
+                it = with_target(it, new_ids[static_cast<size_t>(it)]);
             }
+            rows[new_ids[i]] = std::move(adj_list[i]);
+            degrees[new_ids[i]] = in_degrees[i];
+        }
 
-            *this = std::move(result);
-        } else {
-            DirectedGraph<N> result(number_of_vertices, false);
-
-            size_t already_generated = 0;
-            size_t opt_number = generate_optimal_number(number_of_vertices, number_of_edges);
-
-            std::random_device rd1;
-            std::mt19937 gen1(rd1());
-            std::uniform_int_distribution<> vert_dis(0, number_of_vertices - 1);
-
-            std::random_device rd2;
-            std::mt19937 gen2(rd2());
-            std::uniform_int_distribution<> edge_dis(1, std::min(opt_number, number_of_vertices - 1));
-
-            std::vector<bool> vertices(number_of_vertices, false);
-
-            std::vector<bool> tmp(number_of_vertices, false);
-            while (already_generated != number_of_edges) {
-                size_t current_index = vert_dis(gen1);
-                size_t current_edges = edge_dis(gen2);
-
-                if (std::count(vertices.begin(), vertices.end(), false) > 1) {
-                    while (vertices[current_index]) {
-                        current_index = vert_dis(gen1);
-                    }
-
-                    while (already_generated + current_edges > number_of_edges) {
-                        current_edges = edge_dis(gen2);
-                    }
-                    already_generated += current_edges;
-                } else {
-                    current_index = std::find(vertices.begin(), vertices.end(), false) - vertices.begin();
-
-                    current_edges = number_of_edges - already_generated;
-                    already_generated = number_of_edges;
-                }
-
-                vertices[current_index] = true;
-
-                size_t tmp_counter = 0;
-                std::fill(tmp.begin(), tmp.end(), false);
-                tmp[current_index] = true;
-
-                std::vector<N> tmp_res;
-                tmp_res.reserve(current_edges);
-                while (tmp_counter != current_edges) {
-                    size_t tmp_index = current_index;
-                    while (tmp[tmp_index]) {
-                        tmp_index = vert_dis(gen1);
-                    }
-
-                    ++tmp_counter;
-                    tmp[tmp_index] = true;
-
-                    ++result.in_degrees[tmp_index];
-                    tmp_res.push_back(N(tmp_index));
-                }
+        adj_list = std::move(rows);
+        in_degrees = std::move(degrees);
+        if (indexed) {
+            build_edge_index();
+        }
+    }
 
-                result.adj_list[current_index] = std::move(tmp_res);
-            }
+    template<typename N>
+    void DirectedGraph<N>::generate_random_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight,
+                                                 uint64_t seed) {
+        DirectedGraph<N> result(number_of_vertices, max_weight != 0);
+        generators::gnm(number_of_vertices, number_of_edges, true, seed, max_weight,
+                        [&result](size_t from, size_t to, size_t weight) {
+                            result.add_edge(from, make_edge<N>(to, weight));
+                        });
 
-            *this = std::move(result);
-        }
+        *this = std::move(result);
     }
 
     template<typename N>
     decltype(auto)
-    generate_random_directed_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0) {  // respectively wasn't tested
+    generate_random_directed_graph(size_t number_of_vertices, size_t number_of_edges, size_t max_weight = 0,
+                                   uint64_t seed = std::random_device()()) {
         DirectedGraph<N> result;
-        result.generate_random_graph(number_of_vertices, number_of_edges, max_weight);
+        result.generate_random_graph(number_of_vertices, number_of_edges, max_weight, seed);
         return result;
     }
 
 
     template<typename N>
-    class UndirectedGraph final : public Graph<N> {
+    class UndirectedGraph final : public GraphBase<UndirectedGraph<N>, N> {
+        friend class GraphBase<UndirectedGraph<N>, N>;
+
         size_t edges;
         bool weighted;
         std::vector<std::vector<N>> adj_list;
+        bool indexed;
+        EdgeIndex edge_index;
 
-        void do_reserve(size_t cap) override {
+        void do_reserve(size_t cap) {
             adj_list.reserve(cap);
         };
 
-        size_t get_number_of_vertices() const override {
+        size_t get_number_of_vertices() const {
             return adj_list.size();
         };
 
-        size_t get_number_of_edges() const override {
+        size_t get_number_of_edges() const {
             return edges;
         };
 
-        bool is_empty() const override {
+        bool is_empty() const {
             return adj_list.empty();
         };
 
-        bool check_if_weighted() const override {
-            return weighted;
+        bool check_if_weighted() const {
+            return weighted_edges && weighted;
         };
 
-        void do_add_node(size_t number, N *begin, size_t sz) override;
+        void do_add_node(size_t number, N *begin, size_t sz);
+
+        void do_remove_edge(size_t first, const N &last);
+
+        void do_remove_edge(size_t first);
+
+        void push_edge(size_t first, const N &last) {
+            if (indexed) {
+                edge_index.insert(first, static_cast<size_t>(last), adj_list[first].size());
+            }
+            adj_list[first].push_back(last);
+        };
 
-        void do_remove_edge(size_t first, const N &last) override;
+        size_t find_edge(size_t first, const N &last) const;
 
-        void do_remove_edge(size_t first) override;
+        void pop_edge(size_t first, size_t position);
 
     public:
-        UndirectedGraph() : Graph<N>(), edges(0), weighted(false) {};
+        using node_type = N;
+        using index_type = typename edge_traits<N>::index_type;
+
+        static constexpr bool weighted_edges = edge_traits<N>::weighted;
+
+        using GraphBase<UndirectedGraph<N>, N>::add_node;
+
+        UndirectedGraph() : edges(0), weighted(weighted_edges), indexed(false) {};
+
+        explicit UndirectedGraph(size_t sz) : UndirectedGraph(sz, weighted_edges) {};
 
-        UndirectedGraph(size_t sz, bool w) : Graph<N>(), edges(0), weighted(w), adj_list(sz) {};
+        UndirectedGraph(size_t sz, bool w) : edges(0), weighted(w), adj_list(sz), indexed(false) {
+            if (sz > 0 && sz - 1 > std::numeric_limits<index_type>::max()) {
+                throw std::invalid_argument("too many vertices for the index type");
+            }
+        };
 
         UndirectedGraph(const UndirectedGraph &other) = default;
 
         UndirectedGraph(UndirectedGraph &&other) noexcept: edges(other.edges), weighted(other.weighted),
-                                                           adj_list(std::move(other.adj_list)) {
+                                                           adj_list(std::move(other.adj_list)),
+                                                           indexed(other.indexed),
+                                                           edge_index(std::move(other.edge_index)) {
             other.edges = 0;
+            other.indexed = false;
         };
 
         UndirectedGraph &operator=(const UndirectedGraph<N> &other) = default;
@@ -530,20 +827,47 @@ namespace graph {
             edges = ref.edges;
             weighted = ref.weighted;
             adj_list = std::move(ref.adj_list);
+            indexed = ref.indexed;
+            edge_index = std::move(ref.edge_index);
 
             ref.edges = 0;
+            ref.indexed = false;
             return *this;
         };
 
-        ~UndirectedGraph() override = default;
+        ~UndirectedGraph() = default;
 
         template<typename INIt>
         void add_node(size_t number, INIt begin, INIt end);
 
+        void add_edge(size_t first, const N &last);
+
+        template<typename INIt>
+        void add_edges(INIt begin, INIt end);
+
+        template<typename INIt>
+        void remove_edges(INIt begin, INIt end);
+
+        [[nodiscard]] bool has_edge(size_t first, size_t last) const;
+
+        void build_edge_index();
+
+        void relabel(const std::vector<size_t> &new_ids);
+
+        void drop_edge_index() {
+            indexed = false;
+            edge_index.clear();
+        };
+
+        [[nodiscard]] bool has_edge_index() const {
+            return indexed;
+        };
+
         template<typename T>
         friend std::ostream &operator<<(std::ostream &os, const UndirectedGraph<T> &g);
 
-        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges);
+        void generate_random_graph(size_t number_of_vertices, size_t number_of_edges,
+                                   uint64_t seed = std::random_device()());
 
         auto begin() {
             return adj_list.begin();
@@ -577,7 +901,7 @@ namespace graph {
             for (const auto &it : g.adj_list[i]) {
                 os << it << " ";
             }
-            os << std::endl;
+            os << '\n';
         }
         os << g.number_of_vertices() - 1 << ": ";
         for (const auto &it : g.adj_list[g.number_of_vertices() - 1]) {
@@ -595,58 +919,158 @@ namespace graph {
         if (sz < 1) {
             throw std::invalid_argument("range");
         }
-        if (sz == 1) {
-            return;
-        }
 
-        if (number < Graph<N>::number_of_vertices()) {
-            auto &iter = adj_list[number];
+        if (number < this->number_of_vertices()) {
             for (auto &it = begin; it != end; it = std::next(it)) {
-                iter.push_back(*it);
-                adj_list[static_cast<size_t>(*it)].push_back(static_cast<N>(number));
+                push_edge(number, *it);
+                push_edge(static_cast<size_t>(*it), with_target(static_cast<N>(*it), number));
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_vertices()) {
-            std::vector<N> tmp;
-            tmp.reserve(sz);
+        } else if (number == this->number_of_vertices()) {
+            adj_list.emplace_back();
+            adj_list.back().reserve(sz);
 
             for (auto &it = begin; it != end; it = std::next(it)) {
-                tmp.push_back(*it);
-                adj_list[static_cast<size_t>(*it)].push_back(static_cast<N>(number));
+                push_edge(number, *it);
+                push_edge(static_cast<size_t>(*it), with_target(static_cast<N>(*it), number));
             }
 
-            adj_list.emplace_back(std::move(tmp));
             edges += sz;
         } else {
             throw std::invalid_argument("vertex to add");
         }
     }
 
+    template<typename N>
+    void UndirectedGraph<N>::add_edge(size_t first, const N &last) {
+        if (first >= this->number_of_vertices() ||
+            last >= this->number_of_vertices()) {
+            throw std::invalid_argument("invalid vertices");
+        }
+
+        push_edge(first, last);
+        push_edge(static_cast<size_t>(last), with_target(last, first));
+        ++edges;
+    }
+
+    template<typename N>
+    template<typename INIt>
+    void UndirectedGraph<N>::add_edges(INIt begin, INIt end) {
+        /**
+        *  @brief Appends a batch of (source, node) pairs; the whole batch is validated before anything changes.
+        */
+        size_t count = 0;
+        for (auto it = begin; it != end; ++it, ++count) {
+            if (it->first >= this->number_of_vertices() || it->second >= this->number_of_vertices()) {
+                throw std::invalid_argument("invalid vertices");
+            }
+        }
+
+        if (indexed) {
+            edge_index.reserve(edge_index.size() + 2 * count);
+        }
+        for (auto it = begin; it != end; ++it) {
+            push_edge(it->first, it->second);
+            push_edge(static_cast<size_t>(it->second), with_target(it->second, it->first));
+        }
+        edges += count;
+    }
+
+    template<typename N>
+    template<typename INIt>
+    void UndirectedGraph<N>::remove_edges(INIt begin, INIt end) {
+        for (auto it = begin; it != end; ++it) {
+            do_remove_edge(it->first, it->second);
+        }
+    }
+
+    template<typename N>
+    bool UndirectedGraph<N>::has_edge(size_t first, size_t last) const {
+        if (first >= this->number_of_vertices() || last >= this->number_of_vertices()) {
+            throw std::invalid_argument("invalid vertices");
+        }
+
+        if (indexed) {
+            return edge_index.contains(first, last);
+        }
+        bool shorter = adj_list[first].size() <= adj_list[last].size();       // scan the smaller row
+        const auto &list = adj_list[shorter ? first : last];
+        size_t other = shorter ? last : first;
+        return std::any_of(list.begin(), list.end(), [other](const N &node) {
+            return static_cast<size_t>(node) == other;
+        });
+    }
+
+    template<typename N>
+    void UndirectedGraph<N>::build_edge_index() {
+        /**
+        *  @brief Switches the graph to indexed mode: has_edge and remove_edge become expected O(1)
+        *  at the cost of one hash entry per adjacency entry. Rows edited through operator[] bypass
+        *  the index, call this again after doing so.
+        */
+        edge_index.clear();
+        edge_index.reserve(2 * edges);
+        for (size_t i = 0, end_ = adj_list.size(); i < end_; ++i) {
+            for (size_t j = 0, size_ = adj_list[i].size(); j < size_; ++j) {
+                edge_index.insert(i, static_cast<size_t>(adj_list[i][j]), j);
+            }
+        }
+        indexed = true;
+    }
+
+    template<typename N>
+    size_t UndirectedGraph<N>::find_edge(size_t first, const N &last) const {
+        const auto &list = adj_list[first];
+        if (indexed) {
+            return edge_index.find_if(first, static_cast<size_t>(last), [&list, &last](size_t position) {
+                return list[position] == last;
+            });
+        }
+
+        auto node = std::find(list.begin(), list.end(), last);
+        return node == list.end() ? EdgeIndex::npos : static_cast<size_t>(node - list.begin());
+    }
+
+    template<typename N>
+    void UndirectedGraph<N>::pop_edge(size_t first, size_t position) {
+        auto &list = adj_list[first];
+        size_t back = list.size() - 1;
+        if (indexed) {
+            edge_index.erase(first, static_cast<size_t>(list[position]), position);
+            if (position != back) {
+                edge_index.move(first, static_cast<size_t>(list[back]), back, position);
+            }
+        }
+
+        if (position != back) {
+            list[position] = std::move(list[back]);
+        }
+        list.pop_back();
+    }
+
     template<typename N>
     void UndirectedGraph<N>::do_add_node(size_t number, N *begin, size_t sz) {
         if (!begin) {
             throw std::invalid_argument("list of nodes");
         }
 
-        if (number < Graph<N>::number_of_vertices()) {
-            auto &iter = adj_list[number];
+        if (number < this->number_of_vertices()) {
             for (size_t i = 0; i < sz; ++i) {
-                iter.push_back(*(begin + i));
-                adj_list[static_cast<size_t>(*(begin + i))].push_back(static_cast<N>(number));
+                push_edge(number, *(begin + i));
+                push_edge(static_cast<size_t>(*(begin + i)), with_target(*(begin + i), number));
             }
 
             edges += sz;
-        } else if (number == Graph<N>::number_of_vertices()) {
-            std::vector<N> tmp;
-            tmp.reserve(sz);
+        } else if (number == this->number_of_vertices()) {
+            adj_list.emplace_back();
+            adj_list.back().reserve(sz);
 
             for (size_t i = 0; i < sz; ++i) {
-                tmp.push_back(*(begin + i));
-                adj_list[static_cast<size_t>(*(begin + i))].push_back(static_cast<N>(number));
+                push_edge(number, *(begin + i));
+                push_edge(static_cast<size_t>(*(begin + i)), with_target(*(begin + i), number));
             }
 
-            adj_list.emplace_back(std::move(tmp));
             edges += sz;
         } else {
             throw std::invalid_argument("vertex to add");
@@ -655,164 +1079,175 @@ namespace graph {
 
     template<typename N>
     void UndirectedGraph<N>::do_remove_edge(size_t first, const N &last) {
-        if (first >= Graph<N>::number_of_vertices() ||
-            last >= Graph<N>::number_of_vertices()) {      // N type must implement comparison with size_t type
+        if (first >= this->number_of_vertices() ||
+            last >= this->number_of_vertices()) {      // N type must implement comparison with size_t type
             throw std::invalid_argument("invalid vertices");
         }
 
-        auto &list = adj_list[first];
-        auto node = std::find(list.begin(), list.end(), last);
-
-        if (node != list.end()) {
-            list.erase(node);
+        size_t position = find_edge(first, last);
+        if (position == EdgeIndex::npos) {
+            return;
         }
+        pop_edge(first, position);
 
-        auto &last_list = adj_list[static_cast<size_t>(last)];
-        node = std::find_if(last_list.begin(), last_list.end(), [first](const N &other) {
-            return first == other;
-        });
-        if (node != last_list.end()) {
-            --this->edges;
-            last_list.erase(node);
+        size_t target = static_cast<size_t>(last);
+        size_t twin = find_edge(target, with_target(last, first));      // for a self-loop, the second copy
+        if (twin != EdgeIndex::npos) {
+            pop_edge(target, twin);
         }
+        --edges;
     }
 
     template<typename N>
     void UndirectedGraph<N>::do_remove_edge(size_t first) {
-        if (first >= Graph<N>::number_of_vertices()) {
+        if (first >= this->number_of_vertices()) {
             throw std::invalid_argument("invalid vertex");
         }
 
-        auto &list = adj_list[first];
-        for (size_t i = 0, end_ = list.size(); i < end_; ++i) {
-            auto &tmp = adj_list[static_cast<size_t>(list[i])];
-            auto iter = std::find_if(tmp.begin(), tmp.end(), [first](const N &other) {
-                return first == other;
-            });
-            tmp.erase(iter);
+        std::vector<N> list;
+        list.swap(adj_list[first]);
+        if (indexed) {
+            for (size_t i = 0, end_ = list.size(); i < end_; ++i) {
+                edge_index.erase(first, static_cast<size_t>(list[i]), i);
+            }
         }
 
-        edges -= list.size();
-        list.clear();
+        size_t loops = 0;       // a self-loop is stored twice in its own row
+        for (const auto &it : list) {
+            size_t target = static_cast<size_t>(it);
+            if (target == first) {
+                ++loops;
+                continue;
+            }
+
+            size_t twin = find_edge(target, with_target(it, first));
+            if (twin != EdgeIndex::npos) {
+                pop_edge(target, twin);
+            }
+        }
+
+        edges -= list.size() - loops / 2;
     }
 
     template<typename N>
-    void UndirectedGraph<N>::generate_random_graph(size_t number_of_vertices,
-                                                   size_t number_of_edges) {    // was tested, must work
-        if (static_cast<uint64_t>(number_of_edges) >
-            static_cast<uint64_t>(number_of_vertices) * (number_of_vertices - 1) / 2) {
-            throw std::invalid_argument("cannot create graph with such number of edges");
+    void UndirectedGraph<N>::relabel(const std::vector<size_t> &new_ids) {
+        /**
+        *  @brief Renames every vertex v to new_ids[v], rows and edge targets alike; new_ids must be a permutation.
+        */
+        check_permutation(new_ids, adj_list.size());
+
+        std::vector<std::vector<N>> rows(adj_list.size());
+        for (size_t i = 0, end_ = adj_list.size(); i < end_; ++i) {
+            for (auto &it : adj_list[i]) {
+                it = with_target(it, new_ids[static_cast<size_t>(it)]);
+            }
+            rows[new_ids[i]] = std::move(adj_list[i]);
         }
 
+        adj_list = std::move(rows);
+        if (indexed) {
+            build_edge_index();
+        }
+    }
+
+    template<typename N>
+    void UndirectedGraph<N>::generate_random_graph(size_t number_of_vertices, size_t number_of_edges, uint64_t seed) {
         UndirectedGraph<N> result(number_of_vertices, false);
+        generators::gnm(number_of_vertices, number_of_edges, false, seed, 0,
+                        [&result](size_t from, size_t to, size_t weight) {
+                            result.add_edge(from, make_edge<N>(to, weight));
+                        });
 
-        size_t already_generated = 0;
-        size_t opt_number = generate_optimal_number(number_of_vertices, number_of_edges);
+        *this = std::move(result);
+    }
 
-        std::random_device rd1;
-        std::mt19937 gen1(rd1());
-        std::uniform_int_distribution<> vert_dis(0, number_of_vertices - 1);
+    template<typename N>
+    decltype(auto) generate_random_undirected_unweighted_graph(size_t number_of_vertices, size_t number_of_edges,
+                                                               uint64_t seed = std::random_device()()) {
+        UndirectedGraph<N> result;
+        result.generate_random_graph(number_of_vertices, number_of_edges, seed);
+        return result;
+    }
 
-        std::random_device rd2;
-        std::mt19937 gen2(rd2());
-        std::uniform_int_distribution<> edge_dis(1, std::min(opt_number, number_of_vertices - 1));
 
-        std::vector<bool> vertices(number_of_vertices, false);
+    template<typename G>
+    class GraphAdapter final : public Graph<typename G::node_type> {
+        /**
+        *  @brief Type-erased view of a concrete graph for code that needs runtime polymorphism.
+        *  Hot paths should take the concrete graph as a template parameter instead.
+        */
+        using N = typename G::node_type;
 
-        std::vector<bool> tmp(number_of_vertices, false);
-        while (already_generated != number_of_edges) {
-            size_t current_index = vert_dis(gen1);
-            size_t current_edges = edge_dis(gen2);
+        G &target;
 
-            if (std::count(vertices.begin(), vertices.end(), false) > 1) {
-                while (vertices[current_index]) {
-                    current_index = vert_dis(gen1);
-                }
+        void do_reserve(size_t cap) override {
+            target.reserve(cap);
+        };
 
-                while (already_generated + current_edges > number_of_edges) {
-                    current_edges = edge_dis(gen2);
-                }
-                already_generated += current_edges;
-            } else {
-                current_index = std::find(vertices.begin(), vertices.end(), false) - vertices.begin();
-
-                current_edges = number_of_edges - already_generated;
-                already_generated = number_of_edges;
-
-                while (current_edges >= number_of_vertices) {
-                    std::vector<bool> tmp_mask(number_of_vertices, false);
-
-                    for (size_t i = 0; i < number_of_vertices; ++i) {
-                        if (result.adj_list[i].size() < number_of_vertices) {
-                            size_t decrement = number_of_vertices - result.adj_list[i].size();
-
-                            std::fill(tmp_mask.begin(), tmp_mask.end(), false);
-                            tmp_mask[i] = true;
-                            for (auto &it : result.adj_list[i]) {
-                                tmp_mask[it] = true;
-                            }
-
-                            size_t tmp_counter = 0;
-                            while (tmp_counter != decrement) {
-                                size_t tmp_index = i;
-                                while (tmp_mask[i]) {
-                                    tmp_index = vert_dis(gen1);
-                                }
-
-                                ++tmp_counter;
-                                tmp_mask[tmp_index] = true;
-
-                                result.adj_list[tmp_index].emplace_back(i);
-                                result.adj_list[i].emplace_back(tmp_index);
-                            }
-
-                            current_edges -= decrement;
-                        }
-                    }
-                }
-            }
+        size_t get_number_of_vertices() const override {
+            return target.number_of_vertices();
+        };
+
+        size_t get_number_of_edges() const override {
+            return target.number_of_edges();
+        };
+
+        bool is_empty() const override {
+            return target.empty();
+        };
 
-            vertices[current_index] = true;
+        bool check_if_weighted() const override {
+            return target.is_weighted();
+        };
 
-            size_t initial_size = result.adj_list[current_index].size();
+        void do_add_node(size_t number, N *begin, size_t sz) override {
+            target.add_node(number, begin, sz);
+        };
 
-            size_t tmp_counter = 0;
-            std::fill(tmp.begin(), tmp.end(), false);
-            tmp[current_index] = true;
+        void do_remove_edge(size_t first, const N &last) override {
+            target.remove_edge(first, last);
+        };
 
-            if (initial_size) {
-                for (const auto &it : result.adj_list[current_index]) {
-                    tmp[it] = true;
-                }
-            }
+        void do_remove_edge(size_t first) override {
+            target.remove_edge(first);
+        };
 
-            std::vector<size_t> tmp_res;
-            tmp_res.reserve(current_edges);
-            while (tmp_counter != current_edges) {
-                size_t tmp_index = current_index;
-                while (tmp[tmp_index]) {
-                    tmp_index = vert_dis(gen1);
-                }
+    public:
+        explicit GraphAdapter(G &new_target) : target(new_target) {};
+    };
 
-                ++tmp_counter;
-                tmp[tmp_index] = true;
 
-                tmp_res.emplace_back(tmp_index);
-                result.adj_list[tmp_index].emplace_back(current_index);
-            }
+    template<typename G, typename = void>
+    struct is_graph : std::false_type {
+    };
 
-            result.adj_list[current_index].insert(result.adj_list[current_index].end(),
-                                                  std::make_move_iterator(tmp_res.begin()),
-                                                  std::make_move_iterator(tmp_res.end()));
-        }
+    template<typename G>
+    struct is_graph<G, std::void_t<decltype(std::declval<const G &>().number_of_vertices()),
+                                   decltype(std::declval<const G &>().number_of_edges()),
+                                   decltype(std::declval<const G &>()[0].begin()),
+                                   decltype(std::declval<const G &>()[0].end())>> : std::true_type {
+    };
 
-        *this = std::move(result);
+    template<typename G>
+    constexpr bool is_graph_v = is_graph<G>::value;     // anything with vertex counts and iterable rows
+
+    template<typename E>
+    size_t target_of(const E &edge) {
+        return edge_traits<E>::target(edge);
     }
 
     template<typename N>
-    decltype(auto) generate_random_undirected_unweighted_graph(size_t number_of_vertices, size_t number_of_edges) {
-        UndirectedGraph<N> result;
-        result.generate_random_graph(number_of_vertices, number_of_edges);
-        return result;
+    constexpr bool is_directed(const DirectedGraph<N> &) {
+        return true;
+    }
+
+    template<typename N>
+    constexpr bool is_directed(const UndirectedGraph<N> &) {
+        return false;
+    }
+
+    template<typename G>
+    auto is_directed(const G &g) -> decltype(g.is_directed()) {      // snapshots and mapped views know at runtime
+        return g.is_directed();
     }
 }
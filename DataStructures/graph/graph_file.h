@@ -0,0 +1,433 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graph.h"
+
+
+/*
+ * Binary graph file layout (native byte order, every section starts on an 8-byte boundary):
+ *
+ *   FileHeader
+ *   uint64_t offsets[vertices + 1]          row v occupies neighbors[offsets[v] .. offsets[v + 1])
+ *   Index    neighbors[entries]
+ *   Weight   weights[entries]               present only if FLAG_WEIGHTED is set
+ */
+namespace graph {
+    namespace file {
+        constexpr char MAGIC[8] = {'A', 'D', 'S', 'G', 'R', 'A', 'P', 'H'};
+        constexpr uint32_t VERSION = 1;
+
+        constexpr uint32_t FLAG_DIRECTED = 1u;
+        constexpr uint32_t FLAG_WEIGHTED = 1u << 1u;
+
+        struct FileHeader final {
+            char magic[8];
+            uint32_t version;
+            uint32_t flags;
+            uint32_t index_bytes;
+            uint32_t weight_bytes;
+            uint64_t vertices;
+            uint64_t edges;             // as reported by number_of_edges()
+            uint64_t entries;           // adjacency entries, equals edges for directed graphs
+        };
+
+        static_assert(sizeof(FileHeader) % 8 == 0, "sections must stay 8-byte aligned");
+
+        constexpr uint64_t align_up(uint64_t value) {
+            return (value + 7) & ~static_cast<uint64_t>(7);
+        }
+
+        template<typename T>
+        bool fits(size_t value) {
+            if constexpr (sizeof(T) < sizeof(size_t)) {
+                return value <= std::numeric_limits<T>::max();
+            } else {
+                return true;
+            }
+        }
+
+        inline void write_padding(std::ofstream &out, uint64_t written) {
+            static const char zeros[8] = {};
+            out.write(zeros, static_cast<std::streamsize>(align_up(written) - written));
+        }
+    }
+
+
+    template<typename Index = uint64_t, typename Weight = uint64_t, typename G>
+    void save_binary(const std::string &path, const G &g, bool directed) {
+        static_assert(std::is_unsigned<Index>::value && std::is_unsigned<Weight>::value, "unsigned types expected");
+
+        if (sizeof(Index) < sizeof(size_t) || sizeof(Weight) < sizeof(size_t)) {      // before the file is touched
+            for (const auto &it : g) {
+                for (const auto &node : it) {
+                    if (!file::fits<Index>(target_of(node))) {
+                        throw std::invalid_argument("vertex id does not fit the index type of graph file " + path);
+                    }
+                    if (g.is_weighted() && !file::fits<Weight>(weight_of(node))) {
+                        throw std::invalid_argument("weight does not fit the weight type of graph file " + path);
+                    }
+                }
+            }
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("failed to create graph file " + path);
+        }
+
+        file::FileHeader header{};
+        std::memcpy(header.magic, file::MAGIC, sizeof(header.magic));
+        header.version = file::VERSION;
+        header.flags = (directed ? file::FLAG_DIRECTED : 0u) | (g.is_weighted() ? file::FLAG_WEIGHTED : 0u);
+        header.index_bytes = sizeof(Index);
+        header.weight_bytes = sizeof(Weight);
+        header.vertices = g.number_of_vertices();
+        header.edges = g.number_of_edges();
+
+        std::vector<uint64_t> offsets;
+        offsets.reserve(header.vertices + 1);
+        offsets.push_back(0);
+        for (const auto &it : g) {
+            offsets.push_back(offsets.back() + it.size());
+        }
+        header.entries = offsets.back();
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(offsets.data()),
+                  static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+
+        std::vector<Index> ids;
+        for (const auto &it : g) {
+            ids.clear();
+            for (const auto &node : it) {
+                ids.push_back(static_cast<Index>(target_of(node)));
+            }
+            out.write(reinterpret_cast<const char *>(ids.data()),
+                      static_cast<std::streamsize>(ids.size() * sizeof(Index)));
+        }
+        file::write_padding(out, header.entries * sizeof(Index));
+
+        if (header.flags & file::FLAG_WEIGHTED) {
+            std::vector<Weight> weights;
+            for (const auto &it : g) {
+                weights.clear();
+                for (const auto &node : it) {
+                    weights.push_back(static_cast<Weight>(weight_of(node)));
+                }
+                out.write(reinterpret_cast<const char *>(weights.data()),
+                          static_cast<std::streamsize>(weights.size() * sizeof(Weight)));
+            }
+            file::write_padding(out, header.entries * sizeof(Weight));
+        }
+
+        if (!out) {
+            throw std::runtime_error("failed to write graph file " + path);
+        }
+    }
+
+    template<typename Index = uint64_t, typename Weight = uint64_t, typename N>
+    void save_binary(const std::string &path, const DirectedGraph<N> &g) {
+        save_binary<Index, Weight>(path, g, true);
+    }
+
+    template<typename Index = uint64_t, typename Weight = uint64_t, typename N>
+    void save_binary(const std::string &path, const UndirectedGraph<N> &g) {
+        save_binary<Index, Weight>(path, g, false);
+    }
+
+
+    class MappedFile final {
+        void *address;
+        size_t length;
+
+    public:
+        MappedFile() : address(nullptr), length(0) {};
+
+        explicit MappedFile(const std::string &path) : address(nullptr), length(0) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("failed to open " + path);
+            }
+
+            struct stat info{};
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("failed to stat " + path);
+            }
+
+            length = static_cast<size_t>(info.st_size);
+            if (length) {
+                address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            }
+            ::close(fd);        // the mapping keeps its own reference to the file
+
+            if (address == MAP_FAILED) {
+                address = nullptr;
+                throw std::runtime_error("failed to map " + path);
+            }
+        };
+
+        MappedFile(const MappedFile &other) = delete;
+
+        MappedFile(MappedFile &&other) noexcept: address(other.address), length(other.length) {
+            other.address = nullptr;
+            other.length = 0;
+        };
+
+        MappedFile &operator=(const MappedFile &other) = delete;
+
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+
+            if (address) {
+                ::munmap(address, length);
+            }
+            address = other.address;
+            length = other.length;
+
+            other.address = nullptr;
+            other.length = 0;
+            return *this;
+        };
+
+        ~MappedFile() noexcept {
+            if (address) {
+                ::munmap(address, length);
+            }
+        };
+
+        [[nodiscard]] const char *data() const {
+            return static_cast<const char *>(address);
+        };
+
+        [[nodiscard]] size_t size() const {
+            return length;
+        };
+    };
+
+
+    template<typename Index, typename Weight>
+    class MappedAdjacency final {
+        const Index *ids;
+        const Weight *weights;          // nullptr for unweighted files
+        size_t count;
+
+    public:
+        class Iterator final {
+            const Index *id;
+            const Weight *weight;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = BasicNode<Index, Weight>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = BasicNode<Index, Weight>;
+
+            Iterator(const Index *new_id, const Weight *new_weight) : id(new_id), weight(new_weight) {};
+
+            BasicNode<Index, Weight> operator *() const {
+                return BasicNode<Index, Weight>(*id, weight ? *weight : 1);
+            };
+
+            Iterator &operator ++() {
+                ++id;
+                if (weight) {
+                    ++weight;
+                }
+                return *this;
+            };
+
+            bool operator ==(const Iterator &other) const {
+                return id == other.id;
+            };
+
+            bool operator !=(const Iterator &other) const {
+                return id != other.id;
+            };
+        };
+
+        MappedAdjacency(const Index *new_ids, const Weight *new_weights, size_t new_count) :
+                ids(new_ids), weights(new_weights), count(new_count) {};
+
+        [[nodiscard]] Iterator begin() const {
+            return Iterator(ids, weights);
+        };
+
+        [[nodiscard]] Iterator end() const {
+            return Iterator(ids + count, weights ? weights + count : nullptr);
+        };
+
+        [[nodiscard]] size_t size() const {
+            return count;
+        };
+
+        [[nodiscard]] bool empty() const {
+            return count == 0;
+        };
+
+        BasicNode<Index, Weight> operator [](const size_t &index) const {
+            return BasicNode<Index, Weight>(ids[index], weights ? weights[index] : 1);
+        };
+    };
+
+
+    template<typename Index = uint64_t, typename Weight = uint64_t>
+    class MappedGraph final {
+        MappedFile mapping;
+        file::FileHeader header;
+        const uint64_t *offsets;
+        const Index *ids;
+        const Weight *weights;
+
+    public:
+        class RowIterator final {
+            const MappedGraph *owner;
+            size_t index;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = MappedAdjacency<Index, Weight>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = MappedAdjacency<Index, Weight>;
+
+            RowIterator(const MappedGraph *new_owner, size_t new_index) : owner(new_owner), index(new_index) {};
+
+            MappedAdjacency<Index, Weight> operator *() const {
+                return (*owner)[index];
+            };
+
+            RowIterator &operator ++() {
+                ++index;
+                return *this;
+            };
+
+            bool operator ==(const RowIterator &other) const {
+                return index == other.index;
+            };
+
+            bool operator !=(const RowIterator &other) const {
+                return index != other.index;
+            };
+        };
+
+        explicit MappedGraph(const std::string &path, bool verify = false);
+
+        [[nodiscard]] size_t number_of_vertices() const {
+            return header.vertices;
+        };
+
+        [[nodiscard]] size_t number_of_edges() const {
+            return header.edges;
+        };
+
+        [[nodiscard]] bool empty() const {
+            return header.vertices == 0;
+        };
+
+        [[nodiscard]] bool is_weighted() const {
+            return weights != nullptr;
+        };
+
+        [[nodiscard]] bool is_directed() const {
+            return header.flags & file::FLAG_DIRECTED;
+        };
+
+        [[nodiscard]] size_t degree(const size_t &index) const {
+            return offsets[index + 1] - offsets[index];
+        };
+
+        [[nodiscard]] RowIterator begin() const {
+            return RowIterator(this, 0);
+        };
+
+        [[nodiscard]] RowIterator end() const {
+            return RowIterator(this, header.vertices);
+        };
+
+        MappedAdjacency<Index, Weight> operator [](const size_t &index) const {
+            return MappedAdjacency<Index, Weight>(ids + offsets[index], weights ? weights + offsets[index] : nullptr,
+                                                  degree(index));
+        };
+    };
+
+    template<typename Index, typename Weight>
+    MappedGraph<Index, Weight>::MappedGraph(const std::string &path, bool verify) : mapping(path), header(),
+                                                                                    offsets(nullptr), ids(nullptr),
+                                                                                    weights(nullptr) {
+        /**
+        *  @brief Checks the header and offsets, which costs O(V); with verify the neighbors are checked as well,
+        *  which reads the whole file. Unverified neighbor ids are trusted, so files from other sources should be
+        *  verified once.
+        */
+        if (mapping.size() < sizeof(file::FileHeader)) {
+            throw std::runtime_error("truncated graph file " + path);
+        }
+        std::memcpy(&header, mapping.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, file::MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("not a graph file " + path);
+        }
+        if (header.version != file::VERSION) {
+            throw std::runtime_error("unsupported graph file version in " + path);
+        }
+        if (header.index_bytes != sizeof(Index) || header.weight_bytes != sizeof(Weight)) {
+            throw std::runtime_error("graph file " + path + " was written with different index or weight types");
+        }
+
+        // bounded by the file size first, so the section arithmetic below cannot overflow
+        if (header.vertices >= mapping.size() / sizeof(uint64_t) || header.entries > mapping.size() / sizeof(Index)) {
+            throw std::runtime_error("truncated graph file " + path);
+        }
+        uint64_t offsets_begin = sizeof(file::FileHeader);
+        uint64_t ids_begin = offsets_begin + (header.vertices + 1) * sizeof(uint64_t);
+        uint64_t weights_begin = file::align_up(ids_begin + header.entries * sizeof(Index));
+        uint64_t total = header.flags & file::FLAG_WEIGHTED ?
+                         file::align_up(weights_begin + header.entries * sizeof(Weight)) : weights_begin;
+        if (mapping.size() < total) {
+            throw std::runtime_error("truncated graph file " + path);
+        }
+
+        offsets = reinterpret_cast<const uint64_t *>(mapping.data() + offsets_begin);
+        ids = reinterpret_cast<const Index *>(mapping.data() + ids_begin);
+        if (header.flags & file::FLAG_WEIGHTED) {
+            weights = reinterpret_cast<const Weight *>(mapping.data() + weights_begin);
+        }
+
+        if (offsets[0] != 0 || offsets[header.vertices] != header.entries) {
+            throw std::runtime_error("corrupted offsets in graph file " + path);
+        }
+        for (size_t v = 0; v < header.vertices; ++v) {
+            if (offsets[v] > offsets[v + 1]) {
+                throw std::runtime_error("corrupted offsets in graph file " + path);
+            }
+        }
+        for (size_t i = 0; verify && i < header.entries; ++i) {
+            if (ids[i] >= header.vertices) {
+                throw std::runtime_error("corrupted neighbors in graph file " + path);
+            }
+        }
+    }
+
+    template<typename Index = uint64_t, typename Weight = uint64_t>
+    MappedGraph<Index, Weight> load_binary(const std::string &path, bool verify = false) {
+        return MappedGraph<Index, Weight>(path, verify);
+    }
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "../thread_pool/thread_pool.h"
+
+
+/*
+ * Seeded random edge generators. Every generator calls sink(from, to, weight) once per edge, always from the calling
+ * thread and in the same order for the same arguments, no matter how many threads did the sampling. Edges are
+ * produced in independent blocks whose seeds are derived from the user seed, blocks are sampled in parallel a wave
+ * at a time and handed to the sink in order, so memory stays bounded by the wave rather than by the graph.
+ * max_weight == 0 means an unweighted graph (every weight is 1).
+ */
+namespace graph {
+    namespace generators {
+        constexpr size_t BLOCK_EDGES = 1u << 16u;
+
+        struct Edge final {
+            size_t from;
+            size_t to;
+            size_t weight;
+        };
+
+        namespace detail {
+            inline uint64_t mix(uint64_t value) {       // splitmix64 finalizer
+                value += 0x9e3779b97f4a7c15ull;
+                value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ull;
+                value = (value ^ (value >> 27u)) * 0x94d049bb133111ebull;
+                return value ^ (value >> 31u);
+            }
+
+            inline uint64_t mix(uint64_t seed, uint64_t salt) {
+                return mix(seed ^ mix(salt));
+            }
+
+            inline uint64_t bounded(uint64_t random, uint64_t bound) {      // uniform in [0, bound), Lemire's reduction
+                return static_cast<uint64_t>((static_cast<unsigned __int128>(random) * bound) >> 64u);
+            }
+
+            inline size_t weight(uint64_t seed, uint64_t key, size_t max_weight) {
+                return max_weight ? 1 + bounded(mix(seed ^ 0x5bd1e995u, key), max_weight) : 1;
+            }
+
+            template<typename Produce, typename Sink>
+            void run_blocks(size_t blocks, Produce &&produce, Sink &&sink, size_t threads) {
+                /**
+                *  @brief produce(block, edges) fills edges of one block; blocks are generated threads * 4 at a time.
+                */
+                size_t wave = std::max<size_t>(1, threads) * 4;
+                std::vector<std::vector<Edge>> buffers(std::min(wave, blocks));
+
+                for (size_t first = 0; first < blocks; first += wave) {
+                    size_t count = std::min(wave, blocks - first);
+                    ThreadPool::parallel_for(count, [&](size_t i, size_t) {
+                        buffers[i].clear();
+                        produce(first + i, buffers[i]);
+                    }, threads);
+
+                    for (size_t i = 0; i < count; ++i) {
+                        for (const auto &it : buffers[i]) {
+                            sink(it.from, it.to, it.weight);
+                        }
+                    }
+                }
+            }
+
+            struct SampleBlock final {
+                uint64_t begin;
+                uint64_t end;
+                uint64_t count;
+                uint64_t seed;
+            };
+
+            inline void split_sample(uint64_t begin, uint64_t end, uint64_t count, uint64_t seed,
+                                     std::vector<SampleBlock> &blocks) {
+                /**
+                *  @brief Recursively halves the index range and shares count between halves binomially,
+                *  so that leaves can be sampled independently.
+                */
+                while (count > BLOCK_EDGES && end - begin > 1) {
+                    uint64_t mid = begin + (end - begin) / 2;
+                    std::mt19937_64 gen(seed);
+                    std::binomial_distribution<uint64_t> dis(count, static_cast<double>(mid - begin) /
+                                                                    static_cast<double>(end - begin));
+                    uint64_t left = std::min(std::max(dis(gen), count > end - mid ? count - (end - mid) : 0),
+                                             std::min(count, mid - begin));
+
+                    split_sample(begin, mid, left, mix(seed, 1), blocks);
+                    begin = mid;
+                    count -= left;
+                    seed = mix(seed, 2);
+                }
+                if (count) {
+                    blocks.push_back({begin, end, count, seed});
+                }
+            }
+
+            inline void sample_block(const SampleBlock &block, std::vector<uint64_t> &result) {
+                /**
+                *  @brief Floyd's sampling of count distinct indices of [begin, end), sorted.
+                */
+                uint64_t range = block.end - block.begin;
+                bool complement = block.count > range / 2;
+                uint64_t count = complement ? range - block.count : block.count;
+
+                std::mt19937_64 gen(block.seed);
+                std::unordered_set<uint64_t> chosen;
+                chosen.reserve(count);
+                for (uint64_t j = range - count; j < range; ++j) {
+                    uint64_t t = bounded(gen(), j + 1);
+                    if (!chosen.insert(t).second) {
+                        chosen.insert(j);
+                    }
+                }
+
+                result.clear();
+                if (complement) {
+                    result.reserve(block.count);
+                    for (uint64_t i = 0; i < range; ++i) {
+                        if (!chosen.count(i)) {
+                            result.push_back(block.begin + i);
+                        }
+                    }
+                } else {
+                    result.reserve(count);
+                    for (const auto &it : chosen) {
+                        result.push_back(block.begin + it);
+                    }
+                    std::sort(result.begin(), result.end());
+                }
+            }
+
+            inline void triangle_pair(uint64_t index, size_t &larger, size_t &smaller) {
+                /**
+                *  @brief index-th pair (larger, smaller) of the strictly lower triangle in row-major order.
+                */
+                auto row = static_cast<uint64_t>((1 + std::sqrt(1 + 8 * static_cast<long double>(index))) / 2);
+                while (row * (row - 1) / 2 > index) {
+                    --row;
+                }
+                while ((row + 1) * row / 2 <= index) {
+                    ++row;
+                }
+                larger = row;
+                smaller = index - row * (row - 1) / 2;
+            }
+        }
+
+
+        template<typename Sink>
+        void gnm(size_t number_of_vertices, size_t number_of_edges, bool directed, uint64_t seed, size_t max_weight,
+                 Sink &&sink, size_t threads = ThreadPool::default_threads()) {
+            /**
+            *  @brief Uniform G(n, m): m distinct edges without self-loops. Directed edges come sorted by source,
+            *  undirected ones as (larger, smaller) sorted by the larger endpoint.
+            */
+            uint64_t n = number_of_vertices;
+            uint64_t space = n < 2 ? 0 : (directed ? n * (n - 1) : n * (n - 1) / 2);
+            if (number_of_edges > space) {
+                throw std::invalid_argument("cannot create graph with such number of edges");
+            }
+
+            std::vector<detail::SampleBlock> blocks;
+            detail::split_sample(0, space, number_of_edges, detail::mix(seed), blocks);
+
+            detail::run_blocks(blocks.size(), [&](size_t block, std::vector<Edge> &edges) {
+                std::vector<uint64_t> chosen;
+                detail::sample_block(blocks[block], chosen);
+
+                edges.reserve(chosen.size());
+                for (const auto &it : chosen) {
+                    Edge edge{0, 0, detail::weight(seed, it, max_weight)};
+                    if (directed) {
+                        edge.from = it / (n - 1);
+                        edge.to = it % (n - 1);
+                        edge.to += edge.to >= edge.from ? 1 : 0;
+                    } else {
+                        detail::triangle_pair(it, edge.from, edge.to);
+                    }
+                    edges.push_back(edge);
+                }
+            }, sink, threads);
+        }
+
+        template<typename Sink>
+        void rmat(size_t number_of_vertices, size_t number_of_edges, uint64_t seed, size_t max_weight, Sink &&sink,
+                  size_t threads = ThreadPool::default_threads(), double a = 0.57, double b = 0.19, double c = 0.19) {
+            /**
+            *  @brief Recursive-matrix (Graph500-style) edges. As in the reference generator, duplicates and
+            *  self-loops are kept; vertices past number_of_vertices are redrawn.
+            */
+            if (number_of_vertices == 0 && number_of_edges) {
+                throw std::invalid_argument("cannot create graph with such number of edges");
+            }
+            if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+                throw std::invalid_argument("R-MAT probabilities");
+            }
+
+            size_t scale = 0;
+            while ((static_cast<uint64_t>(1) << scale) < number_of_vertices) {
+                ++scale;
+            }
+            // quadrant thresholds in 32-bit fixed point, one 64-bit draw decides both bits of a level
+            auto ab = static_cast<uint64_t>(std::ldexp(a + b, 32));
+            auto a_of_ab = static_cast<uint64_t>(std::ldexp(a + b > 0 ? a / (a + b) : 0, 32));
+            auto c_of_cd = static_cast<uint64_t>(std::ldexp(a + b < 1 ? c / (1 - a - b) : 0, 32));
+
+            size_t blocks = (number_of_edges + BLOCK_EDGES - 1) / BLOCK_EDGES;
+            detail::run_blocks(blocks, [&](size_t block, std::vector<Edge> &edges) {
+                std::mt19937_64 gen(detail::mix(seed, block));
+                size_t first = block * BLOCK_EDGES;
+                size_t last = std::min(number_of_edges, first + BLOCK_EDGES);
+
+                edges.reserve(last - first);
+                for (size_t i = first; i < last; ++i) {
+                    Edge edge{number_of_vertices, number_of_vertices, detail::weight(seed, i, max_weight)};
+                    while (edge.from >= number_of_vertices || edge.to >= number_of_vertices) {
+                        edge.from = edge.to = 0;
+                        for (size_t level = 0; level < scale; ++level) {
+                            uint64_t random = gen();
+                            bool lower = (random >> 32u) >= ab;
+                            bool right = (random & 0xffffffffu) >= (lower ? c_of_cd : a_of_ab);
+                            edge.from = (edge.from << 1u) | (lower ? 1u : 0u);
+                            edge.to = (edge.to << 1u) | (right ? 1u : 0u);
+                        }
+                    }
+                    edges.push_back(edge);
+                }
+            }, sink, threads);
+        }
+
+        template<typename Sink>
+        void barabasi_albert(size_t number_of_vertices, size_t edges_per_vertex, uint64_t seed, size_t max_weight,
+                             Sink &&sink, size_t threads = ThreadPool::default_threads()) {
+            /**
+            *  @brief Preferential attachment with number_of_vertices * edges_per_vertex edges (from, to), to <= from.
+            *  Uses the Batagelj-Brandes edge array, resolved per position through a hash of the seed (as in
+            *  Sanders-Schulz) so that blocks are independent. Like the sequential original it may emit
+            *  self-loops and duplicates.
+            */
+            if (edges_per_vertex == 0) {
+                throw std::invalid_argument("edges per vertex");
+            }
+
+            uint64_t total = static_cast<uint64_t>(number_of_vertices) * edges_per_vertex;
+            size_t blocks = (total + BLOCK_EDGES - 1) / BLOCK_EDGES;
+            detail::run_blocks(blocks, [&](size_t block, std::vector<Edge> &edges) {
+                uint64_t first = static_cast<uint64_t>(block) * BLOCK_EDGES;
+                uint64_t last = std::min(total, first + BLOCK_EDGES);
+
+                edges.reserve(last - first);
+                for (uint64_t i = first; i < last; ++i) {
+                    uint64_t position = 2 * i + 1;
+                    while (position & 1u) {
+                        position = detail::bounded(detail::mix(seed, position), position);
+                    }
+                    edges.push_back({static_cast<size_t>(i / edges_per_vertex),
+                                     static_cast<size_t>(position / 2 / edges_per_vertex),
+                                     detail::weight(seed, i, max_weight)});
+                }
+            }, sink, threads);
+        }
+    }
+}
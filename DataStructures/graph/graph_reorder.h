@@ -0,0 +1,344 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+
+/*
+ * Locality-improving vertex orders. Every order is returned as new_ids, a permutation with new_ids[old] == new.
+ * relabel() applies one to a graph in place and returns it together with its inverse, old_ids[new] == old, which
+ * translates per-vertex results of the relabelled graph back through restore().
+ * Directed graphs are ordered by their symmetrised structure, so weakly connected parts stay together.
+ */
+namespace graph {
+    namespace reorder {
+        enum class Order {
+            REVERSE_CUTHILL_MCKEE,
+            DEGREE,
+            BFS,
+            DFS
+        };
+
+        struct Permutation final {
+            std::vector<size_t> new_ids;        // new_ids[old] == new
+            std::vector<size_t> old_ids;        // old_ids[new] == old
+        };
+
+        namespace detail {
+            constexpr size_t UNSEEN = std::numeric_limits<size_t>::max();
+
+            struct Structure final {        // symmetric neighbour lists without self-loops, CSR layout
+                std::vector<size_t> offsets;
+                std::vector<size_t> targets;
+
+                [[nodiscard]] size_t size() const {
+                    return offsets.size() - 1;
+                };
+
+                [[nodiscard]] size_t degree(size_t vertex) const {
+                    return offsets[vertex + 1] - offsets[vertex];
+                };
+
+                [[nodiscard]] const size_t *begin(size_t vertex) const {
+                    return targets.data() + offsets[vertex];
+                };
+
+                [[nodiscard]] const size_t *end(size_t vertex) const {
+                    return targets.data() + offsets[vertex + 1];
+                };
+            };
+
+            template<typename G>
+            Structure structure(const G &g) {
+                /**
+                *  @brief Undirected rows already hold both directions; directed edges are added to both endpoints.
+                */
+                bool directed = is_directed(g);
+                size_t n = g.number_of_vertices();
+
+                Structure result;
+                result.offsets.assign(n + 1, 0);
+                for (size_t i = 0; i < n; ++i) {
+                    for (const auto &it : g[i]) {
+                        size_t target = target_of(it);
+                        if (target != i) {
+                            ++result.offsets[i + 1];
+                            if (directed) {
+                                ++result.offsets[target + 1];
+                            }
+                        }
+                    }
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    result.offsets[i + 1] += result.offsets[i];
+                }
+
+                std::vector<size_t> fill(result.offsets.begin(), result.offsets.end() - 1);
+                result.targets.resize(result.offsets[n]);
+                for (size_t i = 0; i < n; ++i) {
+                    for (const auto &it : g[i]) {
+                        size_t target = target_of(it);
+                        if (target != i) {
+                            result.targets[fill[i]++] = target;
+                            if (directed) {
+                                result.targets[fill[target]++] = i;
+                            }
+                        }
+                    }
+                }
+                return result;
+            }
+
+            inline void breadth_first(const Structure &s, size_t start, bool by_degree, std::vector<bool> &visited,
+                                      std::vector<size_t> &sequence) {
+                /**
+                *  @brief Appends the component of start in BFS order; with by_degree the newly discovered
+                *  neighbours of each vertex are queued by ascending degree (Cuthill-McKee).
+                */
+                visited[start] = true;
+                sequence.push_back(start);
+                for (size_t head = sequence.size() - 1; head < sequence.size(); ++head) {
+                    size_t vertex = sequence[head];
+                    size_t discovered = sequence.size();
+                    for (auto it = s.begin(vertex); it != s.end(vertex); ++it) {
+                        if (!visited[*it]) {
+                            visited[*it] = true;
+                            sequence.push_back(*it);
+                        }
+                    }
+
+                    if (by_degree) {
+                        std::sort(sequence.begin() + static_cast<std::ptrdiff_t>(discovered), sequence.end(),
+                                  [&s](size_t lhs, size_t rhs) {
+                                      return std::make_pair(s.degree(lhs), lhs) < std::make_pair(s.degree(rhs), rhs);
+                                  });
+                    }
+                }
+            }
+
+            inline void depth_first(const Structure &s, size_t start, std::vector<bool> &visited,
+                                    std::vector<size_t> &sequence) {
+                std::vector<std::pair<size_t, const size_t *>> stack;
+                visited[start] = true;
+                sequence.push_back(start);
+                stack.emplace_back(start, s.begin(start));
+
+                while (!stack.empty()) {
+                    auto &top = stack.back();
+                    if (top.second == s.end(top.first)) {
+                        stack.pop_back();
+                        continue;
+                    }
+
+                    size_t next = *top.second++;
+                    if (!visited[next]) {
+                        visited[next] = true;
+                        sequence.push_back(next);
+                        stack.emplace_back(next, s.begin(next));
+                    }
+                }
+            }
+
+            inline size_t pseudo_peripheral(const Structure &s, size_t start, std::vector<size_t> &levels,
+                                            std::vector<size_t> &queue) {
+                /**
+                *  @brief George-Liu: hop to a minimum-degree vertex of the last BFS level while the
+                *  eccentricity keeps growing. levels must be all UNSEEN on entry and is left that way.
+                */
+                size_t eccentricity = 0;
+                for (;;) {
+                    queue.clear();
+                    queue.push_back(start);
+                    levels[start] = 0;
+                    for (size_t head = 0; head < queue.size(); ++head) {
+                        size_t vertex = queue[head];
+                        for (auto it = s.begin(vertex); it != s.end(vertex); ++it) {
+                            if (levels[*it] == UNSEEN) {
+                                levels[*it] = levels[vertex] + 1;
+                                queue.push_back(*it);
+                            }
+                        }
+                    }
+
+                    size_t depth = levels[queue.back()];
+                    size_t candidate = queue.back();
+                    for (auto it = queue.rbegin(); it != queue.rend() && levels[*it] == depth; ++it) {
+                        if (s.degree(*it) < s.degree(candidate)) {
+                            candidate = *it;
+                        }
+                    }
+                    for (const auto &it : queue) {
+                        levels[it] = UNSEEN;
+                    }
+
+                    if (depth <= eccentricity) {
+                        return start;
+                    }
+                    eccentricity = depth;
+                    start = candidate;
+                }
+            }
+
+            inline std::vector<size_t> invert(const std::vector<size_t> &sequence) {
+                std::vector<size_t> result(sequence.size());
+                for (size_t i = 0, end_ = sequence.size(); i < end_; ++i) {
+                    result[sequence[i]] = i;
+                }
+                return result;
+            }
+
+            template<typename G>
+            void check_root(const G &g, size_t root) {
+                if (root >= g.number_of_vertices() && !g.empty()) {
+                    throw std::invalid_argument("root vertex");
+                }
+            }
+        }
+
+
+        template<typename G>
+        std::vector<size_t> reverse_cuthill_mckee(const G &g) {
+            /**
+            *  @brief Reverse Cuthill-McKee: every component is laid out by a degree-sorted BFS from a
+            *  pseudo-peripheral vertex, which keeps neighbours close and the adjacency profile narrow.
+            */
+            auto s = detail::structure(g);
+            size_t n = s.size();
+
+            std::vector<bool> visited(n, false);
+            std::vector<size_t> levels(n, detail::UNSEEN);
+            std::vector<size_t> queue;
+            std::vector<size_t> sequence;
+            sequence.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                if (!visited[i]) {
+                    detail::breadth_first(s, detail::pseudo_peripheral(s, i, levels, queue), true, visited, sequence);
+                }
+            }
+
+            std::reverse(sequence.begin(), sequence.end());
+            return detail::invert(sequence);
+        }
+
+        template<typename G>
+        std::vector<size_t> degree_order(const G &g) {
+            /**
+            *  @brief Descending degree, ties by old id: hubs end up packed at the front. Counting sort, O(V + E).
+            */
+            auto s = detail::structure(g);
+            size_t n = s.size();
+
+            size_t max_degree = 0;
+            for (size_t i = 0; i < n; ++i) {
+                max_degree = std::max(max_degree, s.degree(i));
+            }
+
+            std::vector<size_t> first(max_degree + 2, 0);
+            for (size_t i = 0; i < n; ++i) {
+                ++first[max_degree - s.degree(i) + 1];
+            }
+            for (size_t i = 0; i <= max_degree; ++i) {
+                first[i + 1] += first[i];
+            }
+
+            std::vector<size_t> result(n);
+            for (size_t i = 0; i < n; ++i) {
+                result[i] = first[max_degree - s.degree(i)]++;
+            }
+            return result;
+        }
+
+        template<typename G>
+        std::vector<size_t> bfs_order(const G &g, size_t root = 0) {
+            /**
+            *  @brief Breadth-first discovery order from root, remaining components follow by smallest old id.
+            */
+            detail::check_root(g, root);
+            auto s = detail::structure(g);
+            size_t n = s.size();
+
+            std::vector<bool> visited(n, false);
+            std::vector<size_t> sequence;
+            sequence.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                size_t start = (root + i) % n;
+                if (!visited[start]) {
+                    detail::breadth_first(s, start, false, visited, sequence);
+                }
+            }
+            return detail::invert(sequence);
+        }
+
+        template<typename G>
+        std::vector<size_t> dfs_order(const G &g, size_t root = 0) {
+            /**
+            *  @brief Depth-first preorder from root, remaining components follow by smallest old id.
+            */
+            detail::check_root(g, root);
+            auto s = detail::structure(g);
+            size_t n = s.size();
+
+            std::vector<bool> visited(n, false);
+            std::vector<size_t> sequence;
+            sequence.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                size_t start = (root + i) % n;
+                if (!visited[start]) {
+                    detail::depth_first(s, start, visited, sequence);
+                }
+            }
+            return detail::invert(sequence);
+        }
+
+        template<typename G>
+        std::vector<size_t> make_order(const G &g, Order order) {
+            switch (order) {
+                case Order::REVERSE_CUTHILL_MCKEE:
+                    return reverse_cuthill_mckee(g);
+                case Order::DEGREE:
+                    return degree_order(g);
+                case Order::BFS:
+                    return bfs_order(g);
+                case Order::DFS:
+                    return dfs_order(g);
+            }
+            throw std::invalid_argument("order");
+        }
+
+        inline std::vector<size_t> invert(const std::vector<size_t> &new_ids) {
+            return detail::invert(new_ids);
+        }
+
+        template<typename G>
+        Permutation relabel(G &g, const std::vector<size_t> &new_ids) {
+            g.relabel(new_ids);
+            return {new_ids, invert(new_ids)};
+        }
+
+        template<typename G>
+        Permutation relabel(G &g, Order order) {
+            return relabel(g, make_order(g, order));
+        }
+
+        template<typename T>
+        std::vector<T> restore(const std::vector<T> &values, const std::vector<size_t> &old_ids) {
+            /**
+            *  @brief Per-vertex values of a relabelled graph, put back in the original vertex order.
+            */
+            if (values.size() != old_ids.size()) {
+                throw std::invalid_argument("sizes of values and permutation");
+            }
+
+            std::vector<T> result(values.size());
+            for (size_t i = 0, end_ = values.size(); i < end_; ++i) {
+                result[old_ids[i]] = values[i];
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,745 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "graph.h"
+#include "graph_file.h"
+#include "../thread_pool/thread_pool.h"
+
+
+/*
+ * Supported text formats:
+ *
+ *   DIMACS      "c comment", "p sp <n> <m>", "a <u> <v> <w>"; 1-based, directed, weighted
+ *   METIS       "% comment", "<n> <m> [fmt [ncon]]", then one line of 1-based neighbors per vertex
+ *   SNAP        "# comment", "# Nodes: <n> ...", "<u> <v> [w]"; 0-based edge list, n counts isolated vertices
+ *   ADJACENCY   "<u>: <v> (<w>) <v> (<w>) ;" repeated; 1-based, the format of RouteInspectionProblem
+ *
+ * Adjacency formats (METIS and ADJACENCY) list every undirected edge on both endpoints, so they are
+ * folded back into single edges when read into an UndirectedGraph. DIMACS files of undirected graphs usually
+ * hold both arcs of every edge as well, but not always next to each other, so every pair of reciprocal arcs
+ * with the same weight is folded into one edge and an arc without a partner stays an edge of its own.
+ */
+namespace graph {
+    namespace text {
+        enum class Format {
+            DIMACS,
+            METIS,
+            SNAP,
+            ADJACENCY
+        };
+
+        struct Edge final {
+            size_t from;
+            size_t to;
+            size_t weight;
+        };
+
+        struct EdgeList final {
+            size_t vertices = 0;
+            bool weighted = false;
+            std::vector<std::vector<Edge>> parts;       // one part per chunk, in file order
+        };
+
+
+        namespace detail {
+            inline bool is_blank(char c) {
+                return c == ' ' || c == '\t' || c == '\r';
+            }
+
+            inline void skip_blanks(const char *&p, const char *end) {
+                while (p != end && is_blank(*p)) {
+                    ++p;
+                }
+            }
+
+            inline bool parse_number(const char *&p, const char *end, size_t &value) {
+                skip_blanks(p, end);
+                auto result = std::from_chars(p, end, value);
+                if (result.ec != std::errc()) {
+                    return false;
+                }
+                p = result.ptr;
+                return true;
+            }
+
+            inline const char *find_char(const char *p, const char *end, char c) {
+                auto result = static_cast<const char *>(std::memchr(p, c, static_cast<size_t>(end - p)));
+                return result ? result : end;
+            }
+
+            inline std::vector<const char *> split(const char *first, const char *last, char delimiter, size_t parts) {
+                /**
+                *  @brief Cuts [first, last) into parts pieces, each ending right after a delimiter (or at last).
+                */
+                std::vector<const char *> result(parts + 1, last);
+                result[0] = first;
+                for (size_t i = 1; i < parts; ++i) {
+                    const char *p = std::max(result[i - 1], first + (last - first) * i / parts);
+                    p = find_char(p, last, delimiter);
+                    result[i] = p == last ? last : p + 1;
+                }
+                return result;
+            }
+
+            template<typename F>
+            void for_each_line(const char *first, const char *last, F &&f) {
+                while (first < last) {
+                    const char *line_end = find_char(first, last, '\n');
+                    const char *trimmed = line_end;
+                    while (trimmed != first && trimmed[-1] == '\r') {
+                        --trimmed;
+                    }
+                    f(first, trimmed);
+                    first = line_end + 1;
+                }
+            }
+
+            inline const char *next_line(const char *p, const char *end) {
+                p = find_char(p, end, '\n');
+                return p == end ? end : p + 1;
+            }
+
+            inline size_t checked_vertex(size_t value, size_t vertices, const char *format) {
+                if (value == 0 || value > vertices) {
+                    throw std::runtime_error(std::string("vertex out of range in ") + format + " input");
+                }
+                return value - 1;
+            }
+
+            inline void fold_reciprocal(EdgeList &list) {
+                /**
+                *  @brief Drops one arc of every u -> v, v -> u pair of equal weight; the arcs running down are
+                *  dropped, earliest first, so the edges keep the order of the arcs running up.
+                */
+                struct Arc final {
+                    size_t low;
+                    size_t high;
+                    size_t weight;
+                    size_t part;
+                    size_t index;
+                };
+
+                std::vector<Arc> arcs;
+                for (size_t part = 0; part < list.parts.size(); ++part) {
+                    for (size_t i = 0; i < list.parts[part].size(); ++i) {
+                        const auto &it = list.parts[part][i];
+                        if (it.from != it.to) {
+                            arcs.push_back({std::min(it.from, it.to), std::max(it.from, it.to), it.weight, part, i});
+                        }
+                    }
+                }
+                std::sort(arcs.begin(), arcs.end(), [](const Arc &a, const Arc &b) {
+                    return std::tie(a.low, a.high, a.weight, a.part, a.index) <
+                           std::tie(b.low, b.high, b.weight, b.part, b.index);
+                });
+
+                std::vector<std::vector<char>> dropped(list.parts.size());
+                for (size_t part = 0; part < list.parts.size(); ++part) {
+                    dropped[part].assign(list.parts[part].size(), 0);
+                }
+                for (size_t begin = 0, end_ = 0; begin < arcs.size(); begin = end_) {
+                    size_t up = 0, down = 0;
+                    for (end_ = begin; end_ < arcs.size() && arcs[end_].low == arcs[begin].low &&
+                                       arcs[end_].high == arcs[begin].high &&
+                                       arcs[end_].weight == arcs[begin].weight; ++end_) {
+                        ++(list.parts[arcs[end_].part][arcs[end_].index].from == arcs[end_].low ? up : down);
+                    }
+                    for (size_t i = begin, pairs = std::min(up, down); i < end_ && pairs; ++i) {
+                        const auto &it = arcs[i];
+                        if (list.parts[it.part][it.index].from == it.high) {
+                            dropped[it.part][it.index] = 1;
+                            --pairs;
+                        }
+                    }
+                }
+
+                for (size_t part = 0; part < list.parts.size(); ++part) {
+                    auto &edges = list.parts[part];
+                    size_t kept = 0;
+                    for (size_t i = 0; i < edges.size(); ++i) {
+                        if (!dropped[part][i]) {
+                            edges[kept++] = edges[i];
+                        }
+                    }
+                    edges.resize(kept);
+                }
+            }
+
+            inline EdgeList parse_dimacs(const char *first, const char *last, size_t threads, bool symmetric) {
+                EdgeList result;
+                result.weighted = true;
+
+                const char *body = first;
+                bool header = false;
+                while (body < last && !header) {
+                    const char *line = body;
+                    body = next_line(body, last);
+                    skip_blanks(line, body);
+                    if (line == body || *line == 'c' || *line == '\n') {
+                        continue;
+                    }
+
+                    size_t edges = 0;
+                    bool problem_line = *line == 'p';
+                    skip_blanks(++line, body);
+                    while (line != body && !is_blank(*line)) {       // problem type, "sp" for shortest paths
+                        ++line;
+                    }
+                    if (!problem_line || !parse_number(line, body, result.vertices) || !parse_number(line, body, edges)) {
+                        throw std::runtime_error("DIMACS input must start with a \"p sp <n> <m>\" line");
+                    }
+                    header = true;
+                }
+                if (!header) {
+                    throw std::runtime_error("DIMACS input has no problem line");
+                }
+
+                auto bounds = split(body, last, '\n', threads);
+                result.parts.resize(threads);
+                ThreadPool::parallel_for(threads, [&](size_t part, size_t) {
+                    auto &edges = result.parts[part];
+                    for_each_line(bounds[part], bounds[part + 1], [&](const char *p, const char *end) {
+                        skip_blanks(p, end);
+                        if (p == end || *p == 'c') {
+                            return;
+                        }
+
+                        Edge edge{};
+                        if (*p != 'a' || !parse_number(++p, end, edge.from) || !parse_number(p, end, edge.to) ||
+                            !parse_number(p, end, edge.weight)) {
+                            throw std::runtime_error("malformed DIMACS arc line");
+                        }
+                        edge.from = checked_vertex(edge.from, result.vertices, "DIMACS");
+                        edge.to = checked_vertex(edge.to, result.vertices, "DIMACS");
+                        edges.push_back(edge);
+                    });
+                }, threads);
+
+                if (symmetric) {
+                    fold_reciprocal(result);
+                }
+                return result;
+            }
+
+            inline EdgeList parse_metis(const char *first, const char *last, size_t threads, bool symmetric) {
+                EdgeList result;
+
+                const char *body = first;
+                std::string fmt;
+                size_t ncon = 0;
+                bool header = false;
+                while (body < last && !header) {
+                    const char *line = body;
+                    body = next_line(body, last);
+                    skip_blanks(line, body);
+                    if (line == body || *line == '%' || *line == '\n') {
+                        continue;
+                    }
+
+                    size_t edges = 0;
+                    if (!parse_number(line, body, result.vertices) || !parse_number(line, body, edges)) {
+                        throw std::runtime_error("METIS input must start with a \"<n> <m> [fmt [ncon]]\" line");
+                    }
+                    skip_blanks(line, body);
+                    while (line != body && *line >= '0' && *line <= '9') {
+                        fmt.push_back(*line++);
+                    }
+                    parse_number(line, body, ncon);
+                    header = true;
+                }
+                if (!header) {
+                    throw std::runtime_error("METIS input has no header line");
+                }
+
+                fmt.insert(0, fmt.size() < 3 ? 3 - fmt.size() : 0, '0');
+                bool vertex_sizes = fmt[fmt.size() - 3] == '1';
+                size_t vertex_weights = fmt[fmt.size() - 2] == '1' ? std::max<size_t>(ncon, 1) : 0;
+                result.weighted = fmt[fmt.size() - 1] == '1';
+
+                // vertices are implied by line numbers, so the lines of each chunk are counted first
+                auto bounds = split(body, last, '\n', threads);
+                std::vector<size_t> first_vertex(threads + 1, 0);
+                ThreadPool::parallel_for(threads, [&](size_t part, size_t) {
+                    for_each_line(bounds[part], bounds[part + 1], [&](const char *p, const char *end) {
+                        skip_blanks(p, end);
+                        if (p == end || *p != '%') {
+                            ++first_vertex[part + 1];
+                        }
+                    });
+                }, threads);
+                for (size_t i = 0; i < threads; ++i) {
+                    first_vertex[i + 1] += first_vertex[i];
+                }
+                if (first_vertex[threads] < result.vertices) {
+                    throw std::runtime_error("METIS input has fewer vertex lines than declared");
+                }
+
+                result.parts.resize(threads);
+                ThreadPool::parallel_for(threads, [&](size_t part, size_t) {
+                    auto &edges = result.parts[part];
+                    size_t vertex = first_vertex[part];
+                    for_each_line(bounds[part], bounds[part + 1], [&](const char *p, const char *end) {
+                        skip_blanks(p, end);
+                        if (p != end && *p == '%') {
+                            return;
+                        }
+                        if (vertex >= result.vertices) {
+                            if (p != end) {
+                                throw std::runtime_error("METIS input has more vertex lines than declared");
+                            }
+                            return;
+                        }
+
+                        size_t skipped = 0;
+                        for (size_t i = 0, end_ = vertex_weights + (vertex_sizes ? 1 : 0); i < end_; ++i) {
+                            if (!parse_number(p, end, skipped)) {
+                                throw std::runtime_error("malformed METIS vertex line");
+                            }
+                        }
+
+                        bool odd_loop = false;
+                        Edge edge{vertex, 0, 1};
+                        while (skip_blanks(p, end), p != end) {
+                            if (!parse_number(p, end, edge.to) || (result.weighted && !parse_number(p, end, edge.weight))) {
+                                throw std::runtime_error("malformed METIS vertex line");
+                            }
+                            edge.to = checked_vertex(edge.to, result.vertices, "METIS");
+                            if (symmetric && (edge.to < vertex || (edge.to == vertex && (odd_loop = !odd_loop)))) {
+                                continue;
+                            }
+                            edges.push_back(edge);
+                        }
+                        ++vertex;
+                    });
+                }, threads);
+
+                return result;
+            }
+
+            inline EdgeList parse_snap(const char *first, const char *last, size_t threads) {
+                EdgeList result;
+
+                auto bounds = split(first, last, '\n', threads);
+                std::vector<size_t> max_vertex(threads, 0);
+                std::vector<char> weighted(threads, 0);
+                result.parts.resize(threads);
+                ThreadPool::parallel_for(threads, [&](size_t part, size_t) {
+                    auto &edges = result.parts[part];
+                    for_each_line(bounds[part], bounds[part + 1], [&](const char *p, const char *end) {
+                        skip_blanks(p, end);
+                        if (p != end && *p == '#') {        // "# Nodes: <n> Edges: <m>", as write() puts it
+                            size_t declared = 0;
+                            skip_blanks(++p, end);
+                            if (end - p > 6 && std::memcmp(p, "Nodes:", 6) == 0 &&
+                                parse_number(p += 6, end, declared)) {
+                                max_vertex[part] = std::max(max_vertex[part], declared);
+                            }
+                            return;
+                        }
+                        if (p == end || *p == '%') {
+                            return;
+                        }
+
+                        Edge edge{0, 0, 1};
+                        if (!parse_number(p, end, edge.from) || !parse_number(p, end, edge.to)) {
+                            throw std::runtime_error("malformed SNAP edge line");
+                        }
+                        if (skip_blanks(p, end), p != end) {
+                            if (!parse_number(p, end, edge.weight)) {
+                                throw std::runtime_error("malformed SNAP edge line");
+                            }
+                            weighted[part] = 1;
+                        }
+                        max_vertex[part] = std::max(max_vertex[part], std::max(edge.from, edge.to) + 1);
+                        edges.push_back(edge);
+                    });
+                }, threads);
+
+                result.vertices = *std::max_element(max_vertex.begin(), max_vertex.end());
+                result.weighted = std::count(weighted.begin(), weighted.end(), 1) != 0;
+                return result;
+            }
+
+            inline EdgeList parse_adjacency(const char *first, const char *last, size_t threads, bool symmetric) {
+                EdgeList result;
+
+                auto bounds = split(first, last, ';', threads);
+                std::vector<size_t> max_vertex(threads, 0);
+                std::vector<char> weighted(threads, 0);
+                result.parts.resize(threads);
+                ThreadPool::parallel_for(threads, [&](size_t part, size_t) {
+                    auto &edges = result.parts[part];
+                    const char *p = bounds[part];
+                    const char *end_ = bounds[part + 1];
+                    while (p < end_) {
+                        const char *end = find_char(p, end_, ';');
+                        while (p != end && (is_blank(*p) || *p == '\n')) {
+                            ++p;
+                        }
+                        if (p == end) {
+                            p = end + 1;
+                            continue;
+                        }
+
+                        Edge edge{0, 0, 1};
+                        if (!parse_number(p, end, edge.from) || edge.from == 0 || (skip_blanks(p, end), p == end) ||
+                            *p++ != ':') {
+                            throw std::runtime_error("malformed adjacency list entry");
+                        }
+                        max_vertex[part] = std::max(max_vertex[part], edge.from);
+                        --edge.from;
+
+                        bool odd_loop = false;
+                        while (true) {
+                            while (p != end && (is_blank(*p) || *p == '\n')) {
+                                ++p;
+                            }
+                            if (p == end) {
+                                break;
+                            }
+                            if (!parse_number(p, end, edge.to) || edge.to == 0) {
+                                throw std::runtime_error("malformed adjacency list entry");
+                            }
+                            max_vertex[part] = std::max(max_vertex[part], edge.to);
+                            --edge.to;
+
+                            edge.weight = 1;
+                            if (skip_blanks(p, end), p != end && *p == '(') {
+                                if (!parse_number(++p, end, edge.weight) || (skip_blanks(p, end), p == end) ||
+                                    *p++ != ')') {
+                                    throw std::runtime_error("malformed adjacency list entry");
+                                }
+                                weighted[part] = 1;
+                            }
+
+                            if (symmetric &&
+                                (edge.to < edge.from || (edge.to == edge.from && (odd_loop = !odd_loop)))) {
+                                continue;
+                            }
+                            edges.push_back(edge);
+                        }
+                        p = end + 1;
+                    }
+                }, threads);
+
+                result.vertices = *std::max_element(max_vertex.begin(), max_vertex.end());
+                result.weighted = std::count(weighted.begin(), weighted.end(), 1) != 0;
+                return result;
+            }
+
+            inline EdgeList parse(const char *first, const char *last, Format format, size_t threads, bool symmetric) {
+                threads = std::max<size_t>(1, std::min(threads, static_cast<size_t>(last - first) / 4096 + 1));
+                switch (format) {
+                    case Format::DIMACS:
+                        return parse_dimacs(first, last, threads, symmetric);
+                    case Format::METIS:
+                        return parse_metis(first, last, threads, symmetric);
+                    case Format::SNAP:
+                        return parse_snap(first, last, threads);
+                    case Format::ADJACENCY:
+                        return parse_adjacency(first, last, threads, symmetric);
+                }
+                throw std::invalid_argument("format");
+            }
+
+            template<typename N, typename F>
+            void for_each_undirected_edge(const UndirectedGraph<N> &g, F &&f) {
+                /**
+                *  @brief Visits every undirected edge once: from its smaller endpoint, self-loops every second time.
+                */
+                for (size_t i = 0, end_ = g.number_of_vertices(); i < end_; ++i) {
+                    bool odd_loop = false;
+                    for (const auto &it : g[i]) {
+                        size_t target = static_cast<size_t>(it);
+                        if (target > i || (target == i && (odd_loop = !odd_loop))) {
+                            f(i, it);
+                        }
+                    }
+                }
+            }
+        }
+
+
+        class BufferedWriter final {
+            std::FILE *file;
+            std::vector<char> buffer;
+            size_t used;
+
+        public:
+            explicit BufferedWriter(const std::string &path, size_t capacity = 1u << 20u) :
+                    file(std::fopen(path.c_str(), "wb")), buffer(std::max<size_t>(capacity, 64)), used(0) {
+                if (!file) {
+                    throw std::runtime_error("failed to create " + path);
+                }
+            };
+
+            BufferedWriter(const BufferedWriter &other) = delete;
+
+            BufferedWriter &operator=(const BufferedWriter &other) = delete;
+
+            ~BufferedWriter() noexcept {
+                if (file) {
+                    std::fwrite(buffer.data(), 1, used, file);
+                    std::fclose(file);
+                }
+            };
+
+            void flush() {
+                if (used && std::fwrite(buffer.data(), 1, used, file) != used) {
+                    throw std::runtime_error("failed to write output file");
+                }
+                used = 0;
+            };
+
+            void close() {
+                flush();
+                if (std::fclose(file) != 0) {
+                    file = nullptr;
+                    throw std::runtime_error("failed to close output file");
+                }
+                file = nullptr;
+            };
+
+            BufferedWriter &put(char c) {
+                if (used == buffer.size()) {
+                    flush();
+                }
+                buffer[used++] = c;
+                return *this;
+            };
+
+            BufferedWriter &write(const char *data, size_t size) {
+                if (used + size > buffer.size()) {
+                    flush();
+                    if (size > buffer.size()) {
+                        if (std::fwrite(data, 1, size, file) != size) {
+                            throw std::runtime_error("failed to write output file");
+                        }
+                        return *this;
+                    }
+                }
+                std::memcpy(buffer.data() + used, data, size);
+                used += size;
+                return *this;
+            };
+
+            BufferedWriter &write(const char *data) {
+                return write(data, std::strlen(data));
+            };
+
+            BufferedWriter &number(size_t value) {
+                if (buffer.size() - used < 24) {
+                    flush();
+                }
+                auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+                used = static_cast<size_t>(result.ptr - buffer.data());
+                return *this;
+            };
+        };
+
+
+        template<typename N>
+        DirectedGraph<N> parse_directed(const char *first, const char *last, Format format,
+                                        size_t threads = ThreadPool::default_threads()) {
+            auto list = detail::parse(first, last, format, threads, false);
+
+            std::vector<size_t> degrees(list.vertices, 0);
+            for (const auto &part : list.parts) {
+                for (const auto &it : part) {
+                    ++degrees[it.from];
+                }
+            }
+
+            DirectedGraph<N> result(list.vertices, list.weighted);
+            for (size_t i = 0; i < list.vertices; ++i) {
+                result[i].reserve(degrees[i]);
+            }
+            for (const auto &part : list.parts) {
+                for (const auto &it : part) {
+                    result.add_edge(it.from, make_edge<N>(it.to, it.weight));
+                }
+            }
+            return result;
+        }
+
+        template<typename N>
+        UndirectedGraph<N> parse_undirected(const char *first, const char *last, Format format,
+                                            size_t threads = ThreadPool::default_threads()) {
+            auto list = detail::parse(first, last, format, threads, true);
+
+            std::vector<size_t> degrees(list.vertices, 0);
+            for (const auto &part : list.parts) {
+                for (const auto &it : part) {
+                    ++degrees[it.from];
+                    ++degrees[it.to];
+                }
+            }
+
+            UndirectedGraph<N> result(list.vertices, list.weighted);
+            for (size_t i = 0; i < list.vertices; ++i) {
+                result[i].reserve(degrees[i]);
+            }
+            for (const auto &part : list.parts) {
+                for (const auto &it : part) {
+                    result.add_edge(it.from, make_edge<N>(it.to, it.weight));
+                }
+            }
+            return result;
+        }
+
+        template<typename N>
+        DirectedGraph<N> read_directed(const std::string &path, Format format,
+                                       size_t threads = ThreadPool::default_threads()) {
+            MappedFile input(path);
+            return parse_directed<N>(input.data(), input.data() + input.size(), format, threads);
+        }
+
+        template<typename N>
+        UndirectedGraph<N> read_undirected(const std::string &path, Format format,
+                                           size_t threads = ThreadPool::default_threads()) {
+            MappedFile input(path);
+            return parse_undirected<N>(input.data(), input.data() + input.size(), format, threads);
+        }
+
+
+        template<typename Generate>
+        void write_edges(const std::string &path, Format format, size_t vertices, size_t edges, bool weighted,
+                         Generate &&generate) {
+            /**
+            *  @brief Streams generate(sink) to disk, sink(from, to, weight) being called once per edge, without
+            *  building the graph in memory. The header is written first, so edges must be the exact edge count.
+            */
+            BufferedWriter out(path);
+
+            switch (format) {
+                case Format::DIMACS:
+                    out.write("p sp ").number(vertices).put(' ').number(edges).put('\n');
+                    generate([&out](size_t from, size_t to, size_t weight) {
+                        out.write("a ").number(from + 1).put(' ').number(to + 1).put(' ').number(weight).put('\n');
+                    });
+                    break;
+                case Format::SNAP:
+                    out.write("# Nodes: ").number(vertices).write(" Edges: ").number(edges).put('\n');
+                    generate([&out, weighted](size_t from, size_t to, size_t weight) {
+                        out.number(from).put('\t').number(to);
+                        if (weighted) {
+                            out.put('\t').number(weight);
+                        }
+                        out.put('\n');
+                    });
+                    break;
+                default:
+                    throw std::invalid_argument("edge streams can be written as DIMACS or SNAP only");
+            }
+
+            out.close();
+        }
+
+        template<typename N>
+        void write(const std::string &path, const DirectedGraph<N> &g, Format format) {
+            BufferedWriter out(path);
+            size_t n = g.number_of_vertices();
+
+            switch (format) {
+                case Format::DIMACS:
+                    out.write("p sp ").number(n).put(' ').number(g.number_of_edges()).put('\n');
+                    for (size_t i = 0; i < n; ++i) {
+                        for (const auto &it : g[i]) {
+                            out.write("a ").number(i + 1).put(' ').number(static_cast<size_t>(it) + 1).put(' ')
+                               .number(weight_of(it)).put('\n');
+                        }
+                    }
+                    break;
+                case Format::SNAP:
+                    out.write("# Nodes: ").number(n).write(" Edges: ").number(g.number_of_edges()).put('\n');
+                    for (size_t i = 0; i < n; ++i) {
+                        for (const auto &it : g[i]) {
+                            out.number(i).put('\t').number(static_cast<size_t>(it));
+                            if (g.is_weighted()) {
+                                out.put('\t').number(weight_of(it));
+                            }
+                            out.put('\n');
+                        }
+                    }
+                    break;
+                case Format::ADJACENCY:
+                    for (size_t i = 0; i < n; ++i) {
+                        out.number(i + 1).put(':');
+                        for (const auto &it : g[i]) {
+                            out.put(' ').number(static_cast<size_t>(it) + 1).write(" (").number(weight_of(it)).put(')');
+                        }
+                        out.write(i + 1 == n ? " ;" : " ; ");
+                    }
+                    out.put('\n');
+                    break;
+                case Format::METIS:
+                    throw std::invalid_argument("METIS stores undirected graphs only");
+            }
+
+            out.close();
+        }
+
+        template<typename N>
+        void write(const std::string &path, const UndirectedGraph<N> &g, Format format) {
+            BufferedWriter out(path);
+            size_t n = g.number_of_vertices();
+
+            switch (format) {
+                case Format::DIMACS:
+                    out.write("p sp ").number(n).put(' ').number(g.number_of_edges()).put('\n');
+                    detail::for_each_undirected_edge(g, [&out](size_t from, const N &to) {
+                        out.write("a ").number(from + 1).put(' ').number(static_cast<size_t>(to) + 1).put(' ')
+                           .number(weight_of(to)).put('\n');
+                    });
+                    break;
+                case Format::SNAP:
+                    out.write("# Nodes: ").number(n).write(" Edges: ").number(g.number_of_edges()).put('\n');
+                    detail::for_each_undirected_edge(g, [&out, &g](size_t from, const N &to) {
+                        out.number(from).put('\t').number(static_cast<size_t>(to));
+                        if (g.is_weighted()) {
+                            out.put('\t').number(weight_of(to));
+                        }
+                        out.put('\n');
+                    });
+                    break;
+                case Format::METIS:
+                    out.number(n).put(' ').number(g.number_of_edges()).write(g.is_weighted() ? " 001\n" : "\n");
+                    for (size_t i = 0; i < n; ++i) {
+                        bool first_neighbor = true;
+                        for (const auto &it : g[i]) {
+                            if (!first_neighbor) {
+                                out.put(' ');
+                            }
+                            first_neighbor = false;
+                            out.number(static_cast<size_t>(it) + 1);
+                            if (g.is_weighted()) {
+                                out.put(' ').number(weight_of(it));
+                            }
+                        }
+                        out.put('\n');
+                    }
+                    break;
+                case Format::ADJACENCY:
+                    for (size_t i = 0; i < n; ++i) {
+                        out.number(i + 1).put(':');
+                        for (const auto &it : g[i]) {
+                            out.put(' ').number(static_cast<size_t>(it) + 1).write(" (").number(weight_of(it)).put(')');
+                        }
+                        out.write(i + 1 == n ? " ;" : " ; ");
+                    }
+                    out.put('\n');
+                    break;
+            }
+
+            out.close();
+        }
+    }
+}
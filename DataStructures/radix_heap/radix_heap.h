@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../binary_heap/binary_heap.h"
+
+
+namespace RadixHeap {
+    using RadixHeapIterator = size_t;
+
+    template<typename K>
+    class RadixHeap final {
+        /**
+        *  @brief Monotone priority queue for unsigned integer keys (Ahuja, Mehlhorn, Orlin, Tarjan) over the
+        *  values 0..capacity-1. A key lives in the bucket of the highest bit where it differs from the last
+        *  extracted key, so every key moves at most once per bit and no comparisons between keys are made.
+        *  Keys must never be smaller than the last extracted one, which is what Dijkstra guarantees.
+        *  Same interface as BinaryHeap::IndexedBinaryHeap; handles returned by position() are the values.
+        */
+        static_assert(std::is_unsigned<K>::value && std::numeric_limits<K>::digits <= 64,
+                      "radix heap keys must be unsigned integers of at most 64 bits");
+
+        static constexpr size_t BUCKETS = std::numeric_limits<K>::digits + 1;
+
+        std::array<std::vector<size_t>, BUCKETS> buckets;
+        std::vector<size_t> scratch;
+        std::vector<K> keys;
+        std::vector<uint8_t> bucket_of;
+        std::vector<size_t> slots;      // index inside the bucket, npos for values not in the heap
+        K last;
+        size_t count;
+
+        size_t bucket_for(K key) const {
+            auto diff = static_cast<uint64_t>(key ^ last);
+            return diff ? 64 - static_cast<size_t>(__builtin_clzll(diff)) : 0;
+        };
+
+        void push(size_t value) {
+            size_t bucket = bucket_for(keys[value]);
+            bucket_of[value] = static_cast<uint8_t>(bucket);
+            slots[value] = buckets[bucket].size();
+            buckets[bucket].push_back(value);
+        };
+
+        void unlink(size_t value) {
+            auto &bucket = buckets[bucket_of[value]];
+            size_t slot = slots[value];
+            bucket[slot] = bucket.back();
+            slots[bucket[slot]] = slot;
+            bucket.pop_back();
+        };
+
+    public:
+        static constexpr RadixHeapIterator npos = std::numeric_limits<RadixHeapIterator>::max();
+
+        RadixHeap() : last(0), count(0) {};
+
+        explicit RadixHeap(size_t capacity) : keys(capacity), bucket_of(capacity), slots(capacity, npos),
+                                              last(0), count(0) {};
+
+        void resize(size_t capacity) {
+            clear();
+            keys.assign(capacity, K());
+            bucket_of.assign(capacity, 0);
+            slots.assign(capacity, npos);
+        };
+
+        void clear() {
+            for (auto &bucket : buckets) {
+                for (const auto &it : bucket) {
+                    slots[it] = npos;
+                }
+                bucket.clear();
+            }
+            last = 0;
+            count = 0;
+        };
+
+        [[nodiscard]] size_t size() const {
+            return count;
+        };
+
+        [[nodiscard]] bool empty() const {
+            return count == 0;
+        };
+
+        [[nodiscard]] size_t capacity() const {
+            return slots.size();
+        };
+
+        [[nodiscard]] bool contains(size_t value) const {
+            return slots[value] != npos;
+        };
+
+        [[nodiscard]] RadixHeapIterator position(size_t value) const {
+            return slots[value] != npos ? value : npos;
+        };
+
+        RadixHeapIterator insert(const K &key, size_t value);
+
+        BinaryHeap::Node<K, size_t> extract_min();
+
+        BinaryHeap::Node<K, size_t> get_min();
+
+        RadixHeapIterator decrease_key(RadixHeapIterator iter, K new_key);
+
+        RadixHeapIterator insert_or_decrease(const K &key, size_t value) {
+            if (slots[value] == npos) {
+                return insert(key, value);
+            }
+            return decrease_key(value, key);
+        };
+    };
+
+    template<typename K>
+    RadixHeapIterator RadixHeap<K>::insert(const K &key, size_t value) {
+        if (value >= slots.size()) {
+            throw std::logic_error("value exceeds the heap capacity");
+        }
+        if (slots[value] != npos) {
+            throw std::logic_error("value is already in the heap");
+        }
+        if (key < last) {
+            throw std::logic_error("key is smaller than the last extracted one");
+        }
+
+        keys[value] = key;
+        push(value);
+        ++count;
+        return value;
+    }
+
+    template<typename K>
+    BinaryHeap::Node<K, size_t> RadixHeap<K>::get_min() {
+        /**
+        *  @brief Not const: finding the minimum redistributes the lowest non-empty bucket.
+        */
+        if (count == 0) {
+            throw std::logic_error("get_min underflow");
+        }
+
+        if (buckets[0].empty()) {
+            size_t bucket = 1;
+            while (buckets[bucket].empty()) {
+                ++bucket;
+            }
+
+            K minimum = std::numeric_limits<K>::max();
+            for (const auto &it : buckets[bucket]) {
+                minimum = std::min(minimum, keys[it]);
+            }
+
+            last = minimum;
+            scratch.swap(buckets[bucket]);
+            for (const auto &it : scratch) {
+                push(it);       // every key now differs from last in a lower bit
+            }
+            scratch.clear();
+        }
+
+        size_t value = buckets[0].back();
+        return BinaryHeap::Node<K, size_t>(keys[value], value);
+    }
+
+    template<typename K>
+    BinaryHeap::Node<K, size_t> RadixHeap<K>::extract_min() {
+        if (count == 0) {
+            throw std::logic_error("extract_min underflow");
+        }
+
+        auto result = get_min();
+        buckets[0].pop_back();
+        slots[result.get_value()] = npos;
+        --count;
+        return result;
+    }
+
+    template<typename K>
+    RadixHeapIterator RadixHeap<K>::decrease_key(RadixHeapIterator iter, K new_key) {
+        if (iter >= slots.size() || slots[iter] == npos) {
+            throw std::logic_error("decrease_key overflow");
+        }
+        if (keys[iter] < new_key) {
+            throw std::logic_error("new key in decrease_key exceeds the existing key");
+        }
+        if (new_key < last) {
+            throw std::logic_error("key is smaller than the last extracted one");
+        }
+
+        unlink(iter);
+        keys[iter] = new_key;
+        push(iter);
+        return iter;
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace ThreadPool {
+    inline size_t default_threads() {
+        size_t result = std::thread::hardware_concurrency();
+        return result ? result : 1;
+    }
+
+    class Pool final {
+        /**
+        *  @brief Process-wide set of persistent workers. Workers are started on first demand and kept until exit,
+        *  so a parallel loop costs a wake-up and a wait instead of creating and joining threads. One loop runs
+        *  at a time; a loop started from inside a worker runs sequentially on that worker.
+        */
+        std::mutex calls;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::vector<std::thread> workers;
+        size_t generation = 0;
+        size_t active = 0;
+        size_t pending = 0;
+        bool stopping = false;
+        void (*job)(void *, size_t, size_t) = nullptr;
+        void *context = nullptr;
+
+        Pool() = default;
+
+        void work(size_t worker);
+
+    public:
+        Pool(const Pool &) = delete;
+
+        Pool &operator=(const Pool &) = delete;
+
+        ~Pool();
+
+        static Pool &instance() {
+            static Pool result;
+            return result;
+        };
+
+        static bool &inside() {
+            static thread_local bool result = false;
+            return result;
+        };
+
+        template<typename F>
+        void run(size_t threads, F &f);
+    };
+
+    inline Pool::~Pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &it : workers) {
+            it.join();
+        }
+    }
+
+    inline void Pool::work(size_t worker) {
+        inside() = true;
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            if (worker >= active) {
+                continue;
+            }
+
+            auto current = job;
+            auto current_context = context;
+            size_t parts = active + 1;
+            lock.unlock();
+            current(current_context, worker, parts);
+            lock.lock();
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    template<typename F>
+    void Pool::run(size_t threads, F &f) {
+        /**
+        *  @brief Calls f(worker, parts) once for every worker in [0, parts) and returns when all calls have
+        *  finished; parts is at most threads, fewer if not enough workers could be started. The calling thread
+        *  is the last worker. f must not throw.
+        */
+        std::lock_guard<std::mutex> call(calls);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (workers.size() + 1 < threads) {
+            try {
+                workers.emplace_back(&Pool::work, this, workers.size());
+            } catch (...) {
+                break;      // run on the workers that did start; they are joined on exit
+            }
+        }
+
+        active = std::min(threads - 1, workers.size());
+        pending = active;
+        job = [](void *it, size_t worker, size_t parts) { (*static_cast<F *>(it))(worker, parts); };
+        context = &f;
+        ++generation;
+        size_t parts = active + 1;
+        lock.unlock();
+        wake.notify_all();
+
+        inside() = true;
+        f(parts - 1, parts);
+        inside() = false;
+
+        lock.lock();
+        done.wait(lock, [this] { return pending == 0; });
+    }
+
+    template<typename F>
+    void parallel_for(size_t count, F &&f, size_t threads = default_threads()) {
+        /**
+        *  @brief Calls f(index, worker) for every index in [0, count) on the shared pool; the last worker is the
+        *  calling thread. Indices are split into contiguous blocks, one per worker. The first exception thrown
+        *  by any worker is rethrown after all of them have finished.
+        */
+        threads = std::max<size_t>(1, std::min(threads, count));
+        if (threads == 1 || Pool::inside()) {
+            for (size_t i = 0; i < count; ++i) {
+                f(i, static_cast<size_t>(0));
+            }
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(threads);
+        auto run = [&](size_t worker, size_t parts) {
+            try {
+                for (size_t i = count * worker / parts, end_ = count * (worker + 1) / parts; i < end_; ++i) {
+                    f(i, worker);
+                }
+            } catch (...) {
+                errors[worker] = std::current_exception();
+            }
+        };
+        Pool::instance().run(threads, run);
+
+        for (auto &it : errors) {
+            if (it) {
+                std::rethrow_exception(it);
+            }
+        }
+    }
+}